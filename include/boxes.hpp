@@ -0,0 +1,41 @@
+#ifndef BOXES_H
+#define BOXES_H
+
+#include "decide.hpp"
+#include <vector>
+
+// Points per leaf block of a BoxIndex
+static const int BOX_BLOCK = 32;
+
+// Bounding box of a run of points, infinite if one of them has a NaN coordinate
+typedef struct {
+    double minX, maxX;
+    double minY, maxY;
+} PointBox;
+
+/*
+ * Bounding boxes of the points of a point set at doubling block sizes: level 0 has one box per
+ * BOX_BLOCK points, each higher level one box per two boxes of the level below. The box of any run
+ * of points is bounded by the union of O(log N) of them.
+ */
+class BoxIndex {
+public:
+    explicit BoxIndex(const Parameters_t &params);
+
+    int numPoints() const { return points; }
+
+    // A box containing points [first, last], possibly larger
+    PointBox cover(int first, int last) const;
+
+private:
+    int points;
+    std::vector<std::vector<PointBox>> levels;
+};
+
+// Evaluate LIC 0, 1, 7 or 12 skipping the windows whose points lie in a box too small to trigger it
+bool prunedLic(int lic, const Parameters_t &params, const BoxIndex &boxes);
+
+// CMV with LICs 0, 1, 7 and 12 from prunedLic, the others as in computeCMV
+std::array<bool, 15> computeCMV(const BoxIndex &boxes, const Parameters_t &params);
+
+#endif
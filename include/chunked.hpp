@@ -0,0 +1,55 @@
+#ifndef CHUNKED_H
+#define CHUNKED_H
+
+#include "decide.hpp"
+#include <vector>
+
+// Default points per chunk of a ChunkedDecider, 1 MiB of coordinates
+static const int CHUNK_POINTS = 1 << 16;
+
+/*
+ * CMV of a point set streamed in chunks, for recordings too large to hold in memory. The windows
+ * of a LIC are evaluated as soon as their last point has arrived, and only the points a window not
+ * yet evaluated can still need are kept: the last largest-window-span points. Each LIC carries its
+ * latched flags from chunk to chunk, so once a LIC is true it is no longer evaluated. The input
+ * checks depend on the number of points, so they are applied by finish(). Memory is one chunk plus
+ * the largest window span, whatever the number of points, and the CMV is the one computeCMV gives
+ * for the whole point set.
+ */
+class ChunkedDecider {
+public:
+    explicit ChunkedDecider(const Parameters_t &params, int chunkPoints = CHUNK_POINTS);
+
+    // Append points given as separate coordinate arrays
+    void add(const double *X, const double *Y, long long count);
+
+    // Append points given as x0, y0, x1, y1, ...
+    void addInterleaved(const double *XY, long long count);
+
+    // Points appended so far
+    long long numPoints() const { return total; }
+
+    // Evaluate the remaining windows and return the CMV of all appended points
+    std::array<bool, 15> finish();
+
+private:
+    void append(double x, double y);
+    void process();
+
+    Parameters_t params;
+    int chunkPoints;
+    int keep;                       // Points kept between chunks, the largest span of an evaluated LIC
+    bool evaluated[15];             // LICs evaluated while streaming
+    int span[15];
+    unsigned flags[15];             // Flags latched so far
+    long long nextWindow[15];       // First window not evaluated yet
+    long long base = 0;             // Index of the first buffered point
+    long long total = 0;
+    int buffered = 0;
+    std::vector<double> X, Y;
+};
+
+// CMV of a file of interleaved X/Y doubles, mapped and streamed in chunks. False if it cannot be read
+bool chunkedCMVFromFile(const char *path, const Parameters_t &params, int chunkPoints, std::array<bool, 15> &CMV);
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef CONDITIONS_H
+#define CONDITIONS_H
+
+#include "decide.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fixed-size run of bits, one per condition, stored 64 to a word with the bits past size() clear
+class ConditionBits {
+public:
+    explicit ConditionBits(int size = 0) : bits(size), data((size + 63) / 64, 0) {}
+
+    int size() const { return bits; }
+    bool test(int i) const { return data[i >> 6] >> (i & 63) & 1; }
+    void set(int i, bool value = true) {
+        if (value) data[i >> 6] |= uint64_t(1) << (i & 63);
+        else data[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    // True if every bit is set
+    bool all() const;
+    int count() const;
+
+    const std::vector<uint64_t> &words() const { return data; }
+    std::vector<uint64_t> &words() { return data; }
+
+    bool operator==(const ConditionBits &other) const { return bits == other.bits && data == other.data; }
+    bool operator!=(const ConditionBits &other) const { return !(*this == other); }
+
+private:
+    int bits;
+    std::vector<uint64_t> data;
+};
+
+// Evaluates one condition on a point set, context is the pointer given at registration
+typedef bool (*ConditionFunction)(const Parameters_t &params, const void *context);
+
+typedef struct {
+    std::string name;
+    ConditionFunction evaluate;
+    const void *context;
+    double cost;            // Relative cost hint, cheaper conditions are evaluated first by decideConditions
+} Condition;
+
+/*
+ * Conditions a decision can use, numbered in registration order. Conditions 0 to 14 are the LICs,
+ * named "LIC0" to "LIC14" and evaluated with selectLicKernel; site-specific conditions are added
+ * after them.
+ */
+class ConditionRegistry {
+public:
+    ConditionRegistry();
+
+    // Add a condition, returns its number
+    int add(const std::string &name, ConditionFunction evaluate, const void *context, double cost);
+
+    int size() const { return (int)conditions.size(); }
+    const Condition &condition(int i) const { return conditions[i]; }
+
+    // Number of the condition with this name, -1 if there is none
+    int find(const std::string &name) const;
+
+    // Conditions evaluated cheapest first, ties in registration order
+    const std::vector<int> &costOrder() const { return order; }
+
+    // Evaluate every condition
+    ConditionBits computeCMV(const Parameters_t &params) const;
+
+private:
+    std::vector<Condition> conditions;
+    std::vector<int> order;
+};
+
+/*
+ * LCM and PUV over any number of conditions. Row i of the LCM is kept as the bits of the columns
+ * connected to i by ANDD and by ORR, so a PUM row is a few word operations per 64 conditions
+ * instead of one switch per entry. The diagonal is ignored, as in generatePreliminaryUnlockingMatrix.
+ */
+class UnlockingLogic {
+public:
+    explicit UnlockingLogic(int conditions);
+
+    // The 15-condition LCM and PUV of the classic decision
+    UnlockingLogic(const std::array<std::array<Connectors, 15>, 15> &LCM, std::array<bool, 15> PUV);
+
+    int size() const { return (int)andRows.size(); }
+
+    // Set LCM[row][column], leaving LCM[column][row] as it is
+    void setConnector(int row, int column, Connectors connector);
+    Connectors connector(int row, int column) const;
+
+    void setPUV(int i, bool value) { puv.set(i, value); }
+    const ConditionBits &PUV() const { return puv; }
+
+    // Row i of the PUM for a CMV, the diagonal set
+    ConditionBits PUMRow(const ConditionBits &CMV, int i) const;
+    std::vector<ConditionBits> PUM(const ConditionBits &CMV) const;
+    ConditionBits FUV(const ConditionBits &CMV) const;
+    bool launch(const ConditionBits &CMV) const;
+
+    // Conditions the launch decision depends on
+    ConditionBits readConditions() const;
+
+    // True if some row of the PUV fails whatever the conditions not yet known turn out to be
+    bool settledNoLaunch(const ConditionBits &known, const ConditionBits &CMV) const;
+
+private:
+    bool rowTrue(const ConditionBits &CMV, int i) const;
+
+    std::vector<ConditionBits> andRows;
+    std::vector<ConditionBits> orRows;
+    ConditionBits puv;
+};
+
+/*
+ * Launch decision of a registry and unlocking logic of the same size. Only conditions that can
+ * change the decision are evaluated, cheapest first, and evaluation stops as soon as a row of the
+ * PUV is known to fail. Conditions not evaluated are false in CMV.
+ */
+bool decideConditions(const ConditionRegistry &registry, const UnlockingLogic &logic, const Parameters_t &params,
+                      ConditionBits *CMV = nullptr);
+
+#endif
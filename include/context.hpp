@@ -0,0 +1,40 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include "features.hpp"
+#include "kernels.hpp"
+
+/*
+ * Scratch space of a decision, owned by the caller and reused between decisions. The context keeps
+ * the FeatureColumns of the point set, so the quantities shared by several LICs are computed once,
+ * and holds the CMV, PUM and FUV of the last decision. Buffers only grow, so once a context has seen
+ * its largest point set, decide() does not touch the heap.
+ */
+class DecideContext {
+public:
+    explicit DecideContext(int maxPoints = 0);
+
+    // Grow the buffers to hold point sets of maxPoints points
+    void reserve(int maxPoints);
+
+    // Largest point set decide() handles without allocating
+    int capacity() const;
+
+    // Run the whole decision of a plan on a point set, returns the launch decision
+    bool decide(const DecidePlan &plan, const double *X, const double *Y, int numPoints);
+
+    // Results of the last decision
+    const std::array<bool, 15> &CMV() const { return cmv; }
+    const std::array<std::array<bool, 15>, 15> &PUM() const { return pum; }
+    const std::array<bool, 15> &FUV() const { return fuv; }
+    bool launch() const { return launched; }
+
+private:
+    FeatureColumns features;
+    std::array<bool, 15> cmv{};
+    std::array<std::array<bool, 15>, 15> pum{};
+    std::array<bool, 15> fuv{};
+    bool launched = false;
+};
+
+#endif
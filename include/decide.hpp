@@ -3,6 +3,8 @@
 
 #include <cmath>
 #include <array>
+#include <cfloat>
+#include <cstdint>
 
 static const double PI = 3.1415926535;
 
@@ -38,8 +40,46 @@ typedef struct {
     double AREA2;       // Max area in LIC 14
 } Parameters_t;
 
-// Compare floating point numbers
-Comptype doubleCompare (double a, double b);
+/**
+ * Compares two double values with a precision tolerance.
+ *
+ * This function compares two double values `a` and `b` to determine their
+ * relative difference within a specified precision tolerance of 0.000001.
+ * It returns EQ if the values are nearly equal, LT if `a` is less than `b`,
+ * and GT if `a` is greater than `b`. Defined inline as every LIC window calls it.
+ *
+ * @param a First double value to compare.
+ * @param b Second double value to compare.
+ * @return CompType Comparison result: EQ, LT, or GT.
+ */
+inline Comptype doubleCompare (double a, double b) {
+    if (fabs(a-b) < 0.000001) return EQ;
+    if (a < b) return LT;
+    return GT;
+}
+
+/**
+ * Compares two float values with a precision tolerance.
+ *
+ * Same as doubleCompare, but 0.000001 is below one float rounding step once the values
+ * pass 8, so the tolerance grows to 8 rounding steps of the larger value.
+ *
+ * @param a First float value to compare.
+ * @param b Second float value to compare.
+ * @return CompType Comparison result: EQ, LT, or GT.
+ */
+inline Comptype floatCompare (float a, float b) {
+    float magnitude = std::fabs(a) > std::fabs(b) ? std::fabs(a) : std::fabs(b);
+    float tolerance = 8 * FLT_EPSILON * magnitude;
+    if (tolerance < 0.000001f) tolerance = 0.000001f;
+    if (std::fabs(a-b) < tolerance) return EQ;
+    if (a < b) return LT;
+    return GT;
+}
+
+// doubleCompare or floatCompare by the type of the values, for code templated on the scalar type
+inline Comptype scalarCompare (double a, double b) { return doubleCompare(a, b); }
+inline Comptype scalarCompare (float a, float b) { return floatCompare(a, b); }
 
 // The goal DECIDE function. 
 void decide();
@@ -89,11 +129,20 @@ bool lic13(Parameters_t params);
 // LIC 14
 bool lic14(Parameters_t params);
 
+// Evaluate a single LIC by number
+bool evaluateLic(int lic, Parameters_t params);
+
+// Compute the full Conditions Met Vector
+std::array<bool, 15> computeCMV(Parameters_t params);
+
+// Pack a CMV into a bitmask, bit i is CMV[i]
+uint16_t cmvToMask(std::array<bool, 15> CMV);
+
 // Generate PUV
-std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::array<bool, 15> CMV, std::array<std::array<Connectors, 15>, 15> LCM);
+std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::array<bool, 15> CMV, const std::array<std::array<Connectors, 15>, 15> &LCM);
 
 // Generate FUV
-std::array<bool, 15> generateFinalUnlockingVector(std::array<std::array<bool, 15>, 15> PUM, std::array<bool, 15> PUV);
+std::array<bool, 15> generateFinalUnlockingVector(const std::array<std::array<bool, 15>, 15> &PUM, std::array<bool, 15> PUV);
 
 // Launch Decision
 bool launchDecision(std::array<bool, 15> FUV);
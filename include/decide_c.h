@@ -0,0 +1,102 @@
+#ifndef DECIDE_C_H
+#define DECIDE_C_H
+
+/*
+ * C interface of libdecide. Only plain C types cross this boundary, plans and sessions are opaque
+ * handles, and every output buffer is owned by the caller. Functions return DECIDE_SUCCESS or a
+ * negative error code and never throw.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define DECIDE_API __attribute__((visibility("default")))
+#else
+#define DECIDE_API
+#endif
+
+// Version of this interface, bumped on incompatible changes
+#define DECIDE_ABI_VERSION 1
+
+// Return codes
+#define DECIDE_SUCCESS 0
+#define DECIDE_EINVAL (-1)          // Null pointer or invalid argument
+#define DECIDE_ENOMEM (-2)          // Allocation failed
+
+// Connectors in the LCM passed to decide_plan_create
+#define DECIDE_NOTUSED 0
+#define DECIDE_ORR 1
+#define DECIDE_ANDD 2
+
+// LIC thresholds and separations, same meaning as in Parameters_t
+typedef struct {
+    double LENGTH1;
+    double RADIUS1;
+    double EPSILON;
+    double AREA1;
+    double DIST;
+    double LENGTH2;
+    double RADIUS2;
+    double AREA2;
+    int32_t Q_PTS;
+    int32_t QUADS;
+    int32_t N_PTS;
+    int32_t K_PTS;
+    int32_t A_PTS;
+    int32_t B_PTS;
+    int32_t C_PTS;
+    int32_t D_PTS;
+    int32_t E_PTS;
+    int32_t F_PTS;
+    int32_t G_PTS;
+} decide_params;
+
+// One point set of a batch
+typedef struct {
+    const double *x;
+    const double *y;
+    int32_t numpoints;
+} decide_points;
+
+// Result of one decision
+typedef struct {
+    uint16_t cmv;               // Bit i is CMV[i]
+    uint16_t fuv;               // Bit i is FUV[i]
+    uint8_t launch;             // 1 if launch, else 0
+    uint8_t reserved[3];
+} decide_result;
+
+// Parameters and launch configuration of a mission, immutable once created
+typedef struct decide_plan decide_plan;
+
+// Per-thread state for running decisions with a plan, keeps its scratch space between decisions
+typedef struct decide_session decide_session;
+
+// Returns DECIDE_ABI_VERSION of the library
+DECIDE_API int decide_abi_version(void);
+
+// Create a plan, lcm holds 15x15 connectors row by row (symmetric), bit i of puv is PUV[i]
+DECIDE_API int decide_plan_create(const decide_params *params, const uint8_t lcm[225], uint16_t puv, decide_plan **plan);
+
+DECIDE_API void decide_plan_destroy(decide_plan *plan);
+
+// Create a session for a plan, the plan must outlive the session
+DECIDE_API int decide_session_create(const decide_plan *plan, decide_session **session);
+
+DECIDE_API void decide_session_destroy(decide_session *session);
+
+// Decide one point set
+DECIDE_API int decide_run(decide_session *session, const double *x, const double *y, int32_t numpoints, decide_result *result);
+
+// Decide count point sets, results receives count entries
+DECIDE_API int decide_run_batch(decide_session *session, const decide_points *items, int32_t count, decide_result *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include "kernels.hpp"
+#include "scheduler.hpp"
+
+// Ways a LicDispatcher can evaluate a LIC
+typedef enum {
+    LIC_SCALAR,         // evaluateLic, one window at a time
+    LIC_KERNEL,         // selectLicKernel: fixed-separation and SIMD kernels
+    LIC_PRUNED,         // prunedLic on a BoxIndex, LICs 0, 1, 7 and 12 only
+    LIC_THREADED,       // Windows split into SCHEDULER_CHUNK tasks on the pool
+    LIC_IMPLEMENTATIONS
+} LicImplementation;
+
+// Point count classes of a calibration: up to 8, 32, 128, ... points, larger sets use the last one
+static const int DISPATCH_SIZES = 10;
+
+// Window span classes of a calibration: spans below DISPATCH_WIDE_SPAN and the rest
+static const int DISPATCH_SPANS = 2;
+static const int DISPATCH_WIDE_SPAN = 16;
+
+/*
+ * Picks the fastest implementation of each LIC for the size of its input. The choice is a table
+ * indexed by LIC, point count class and window span class, filled by timing every implementation
+ * on synthetic point sets where no LIC triggers early, or loaded from a profile saved on an
+ * earlier run. Until then every entry is LIC_KERNEL, what computeCMV(plan, ...) uses. All the
+ * implementations give the same result, so the choice only changes the time taken.
+ */
+class LicDispatcher {
+public:
+    // pool: threads for LIC_THREADED, which is never chosen without one
+    explicit LicDispatcher(WorkStealingPool *pool = nullptr);
+
+    // Time every implementation on point sets of up to maxPoints points, keeping the best of repetitions
+    void calibrate(int maxPoints, int repetitions = 3);
+
+    // Read or write the table as text, false if the file cannot be read or written or is not a profile
+    bool load(const char *path);
+    bool save(const char *path) const;
+
+    LicImplementation choice(int lic, const Parameters_t &params) const;
+    void setChoice(int lic, int sizeClass, int spanClass, LicImplementation implementation);
+
+    bool evaluate(int lic, const Parameters_t &params) const;
+
+    // CMV with every LIC evaluated by its chosen implementation
+    std::array<bool, 15> computeCMV(const Parameters_t &params) const;
+
+private:
+    WorkStealingPool *pool;
+    LicImplementation table[15][DISPATCH_SIZES][DISPATCH_SPANS];
+};
+
+// Point count class of a point set of numPoints points
+int dispatchSizeClass(int numPoints);
+
+// Points and parameters calibrate times a span class with, no LIC triggers on them
+void calibrationPoints(double *X, double *Y, int numPoints);
+Parameters_t calibrationParameters(int spanClass, double *X, double *Y, int numPoints);
+
+// Evaluate a LIC with one implementation, pool is only used by LIC_THREADED
+bool evaluateLicWith(LicImplementation implementation, int lic, const Parameters_t &params, WorkStealingPool *pool);
+
+#endif
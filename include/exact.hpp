@@ -0,0 +1,234 @@
+#ifndef EXACT_H
+#define EXACT_H
+
+#include "lic_windows.hpp"
+#include <cstdint>
+
+/*
+ * Exact mode for fixed-point integer coordinates. Every LIC test is rewritten on squared
+ * quantities (squared distances, twice the signed area as a cross product, dot products) and
+ * evaluated in 128-bit integers, so the hot path has no floating point and the result does not
+ * depend on the machine. The double thresholds are quantized once, in makeExactPlan, to whole
+ * coordinate units: a test against a single squared quantity then gives the same answer as the
+ * real threshold, and tests against a product of quantities (circumradius, distance from a line)
+ * use the quantized value.
+ *
+ * The geometry follows the specification of each LIC, so a few LICs intentionally differ from the
+ * double engine: no doubleCompare tolerance, LICs 2 and 9 treat exactly straight angles as
+ * straight, LIC 9 uses the angle between BA and BC, and LICs 10 and 14 use the triangle area.
+ * The window counts and input checks are those of licWindowCount.
+ */
+
+typedef __int128 ExactInt;
+typedef unsigned __int128 ExactUInt;
+
+// Coordinates must lie in [-EXACT_COORD_LIMIT, EXACT_COORD_LIMIT] so the products fit 128 bits
+static const int64_t EXACT_COORD_LIMIT = (int64_t)1 << 30;
+
+// Integer points accessor
+template <typename T>
+struct IntegerPoints {
+    const T *X;
+    const T *Y;
+    int64_t x(int i) const { return X[i]; }
+    int64_t y(int i) const { return Y[i]; }
+};
+
+// Thresholds of a Parameters_t quantized to coordinate units
+typedef struct {
+    Parameters_t params;        // Separations and the original thresholds, points unused
+    ExactInt length1Sq;         // d > LENGTH1 iff d^2 > length1Sq (LICs 0, 7, 12)
+    ExactInt length2Sq;         // d < LENGTH2 iff d^2 < length2Sq (LIC 12)
+    ExactInt diameter1Sq;       // d > 2 RADIUS1 iff d^2 > diameter1Sq (LICs 1, 8, 13)
+    ExactInt diameter2Sq;       // (2 RADIUS2)^2 (LIC 13)
+    ExactInt area1Twice;        // area > AREA1 iff |cross| > area1Twice (LICs 3, 10, 14)
+    ExactInt area2Twice;        // area < AREA2 iff |cross| < area2Twice (LIC 14)
+    ExactInt distSq;            // DIST^2 (LIC 6)
+    int angleMode;              // EXACT_ANGLE_*, how LICs 2 and 9 test EPSILON
+    int64_t cosEpsilon;         // cos(EPSILON) * 2^30
+    int64_t sinEpsilon;         // sin(EPSILON) * 2^30
+} ExactPlan;
+
+// How an exact plan tests the deviation from a straight angle against EPSILON
+enum { EXACT_ANGLE_ALWAYS, EXACT_ANGLE_NEVER, EXACT_ANGLE_BENT, EXACT_ANGLE_DIRECTION };
+
+// Quantize the thresholds of params for coordinates with unitsPerLength units per unit of length
+ExactPlan makeExactPlan(const Parameters_t &params, double unitsPerLength);
+
+// True if every coordinate lies within EXACT_COORD_LIMIT
+bool exactCoordinatesInRange(const int32_t *X, const int32_t *Y, int numPoints);
+bool exactCoordinatesInRange(const int64_t *X, const int64_t *Y, int numPoints);
+
+// a * b > c * d without overflow, for c * d of either sign
+bool exactProductGreater(ExactUInt a, ExactUInt b, ExactInt c, ExactUInt d);
+
+template <typename Points>
+inline ExactInt exactDistanceSq(const Points &pts, int i, int j) {
+    ExactInt dx = pts.x(j) - pts.x(i), dy = pts.y(j) - pts.y(i);
+    return dx * dx + dy * dy;
+}
+
+// (a - o) x (b - o), twice the signed area of the triangle oab
+template <typename Points>
+inline ExactInt exactCross(const Points &pts, int o, int a, int b) {
+    ExactInt ax = pts.x(a) - pts.x(o), ay = pts.y(a) - pts.y(o);
+    ExactInt bx = pts.x(b) - pts.x(o), by = pts.y(b) - pts.y(o);
+    return ax * by - ay * bx;
+}
+
+// (a - o) . (b - o)
+template <typename Points>
+inline ExactInt exactDot(const Points &pts, int o, int a, int b) {
+    ExactInt ax = pts.x(a) - pts.x(o), ay = pts.y(a) - pts.y(o);
+    ExactInt bx = pts.x(b) - pts.x(o), by = pts.y(b) - pts.y(o);
+    return ax * bx + ay * by;
+}
+
+inline ExactInt exactAbs(ExactInt v) {
+    return v < 0 ? -v : v;
+}
+
+// Angle at vertex v between a and c deviates from straight by more than EPSILON
+template <typename Points>
+inline unsigned exactBentAngle(const ExactPlan &plan, const Points &pts, int a, int v, int c) {
+    if (exactDistanceSq(pts, v, a) == 0 || exactDistanceSq(pts, v, c) == 0) return 0;
+    ExactInt cross = exactAbs(exactCross(pts, v, a, c));
+    ExactInt dot = exactDot(pts, v, a, c);
+    switch (plan.angleMode) {
+    case EXACT_ANGLE_ALWAYS: return 1;
+    case EXACT_ANGLE_NEVER: return 0;
+    case EXACT_ANGLE_BENT: return cross != 0 || dot > 0;
+    }
+    // The deviation d = atan2(|cross|, -dot) exceeds EPSILON iff sin(d - EPSILON) > 0
+    return plan.cosEpsilon * cross + plan.sinEpsilon * dot > 0;
+}
+
+// Circumradius of the triangle abc compared with a quantized squared diameter, the caller checks
+// that the triangle is not degenerate. Returns 1 if larger, 0 otherwise
+template <typename Points>
+inline unsigned exactCircumradiusGreater(const Points &pts, int a, int b, int c, ExactInt diameterSq) {
+    // R = |ab| |ac| |bc| / (2 |cross|), so 2R > D iff |ab|^2 |ac|^2 |bc|^2 > D^2 cross^2
+    ExactUInt sides = (ExactUInt)exactDistanceSq(pts, a, b) * (ExactUInt)exactDistanceSq(pts, a, c);
+    ExactInt cross = exactCross(pts, a, b, c);
+    return exactProductGreater(sides, exactDistanceSq(pts, b, c), diameterSq, (ExactUInt)(cross * cross));
+}
+
+template <typename Points>
+inline unsigned exactLic0Window(const ExactPlan &plan, const Points &pts, int i) {
+    return exactDistanceSq(pts, i, i + 1) > plan.length1Sq;
+}
+
+template <typename Points>
+inline unsigned exactLic1Window(const ExactPlan &plan, const Points &pts, int i) {
+    return exactDistanceSq(pts, i, i + 1) > plan.diameter1Sq;
+}
+
+template <typename Points>
+inline unsigned exactLic3Window(const ExactPlan &plan, const Points &pts, int i) {
+    return exactAbs(exactCross(pts, i, i + 1, i + 2)) > plan.area1Twice;
+}
+
+template <typename Points>
+inline unsigned exactLic4Window(const ExactPlan &plan, const Points &pts, int j) {
+    unsigned quads = 0;
+    for (int i = j; i < j + plan.params.Q_PTS; i++) {
+        quads |= 1u << pointQuadrant(pts.x(i), pts.y(i));
+    }
+    int count = (quads & 1) + (quads >> 1 & 1) + (quads >> 2 & 1) + (quads >> 3 & 1);
+    return plan.params.QUADS < count;
+}
+
+template <typename Points>
+inline unsigned exactLic6Window(const ExactPlan &plan, const Points &pts, int i) {
+    int last = i + plan.params.N_PTS - 1;
+    ExactInt baseSq = exactDistanceSq(pts, i, last);
+    for (int j = i + 1; j < last; j++) {
+        if (baseSq == 0) {
+            if (exactDistanceSq(pts, i, j) > plan.distSq) return 1;
+        } else {
+            // Distance from the line is |cross| / |base|
+            ExactInt cross = exactCross(pts, i, last, j);
+            if (exactProductGreater((ExactUInt)(cross * cross), 1, plan.distSq, (ExactUInt)baseSq)) return 1;
+        }
+    }
+    return 0;
+}
+
+template <typename Points>
+inline unsigned exactLic8Window(const ExactPlan &plan, const Points &pts, int i) {
+    int b = i + plan.params.A_PTS + 1;
+    int c = b + plan.params.B_PTS + 1;
+    ExactInt ab = exactDistanceSq(pts, i, b), ac = exactDistanceSq(pts, i, c), bc = exactDistanceSq(pts, b, c);
+    if (ab > plan.diameter1Sq || ac > plan.diameter1Sq || bc > plan.diameter1Sq) return 1;
+
+    // Twice the vector from the midpoint of the longest side to the remaining point
+    int apex = i, end1 = b, end2 = c;
+    if (ab > ac && ab > bc) {
+        apex = c, end1 = i, end2 = b;
+    } else if (ac > ab && ac > bc) {
+        apex = b, end1 = i, end2 = c;
+    }
+    ExactInt mx = 2 * (ExactInt)pts.x(apex) - pts.x(end1) - pts.x(end2);
+    ExactInt my = 2 * (ExactInt)pts.y(apex) - pts.y(end1) - pts.y(end2);
+    if (mx * mx + my * my <= plan.diameter1Sq) return 0;
+
+    if (exactCross(pts, i, b, c) == 0) return 0;
+    return exactCircumradiusGreater(pts, i, b, c, plan.diameter1Sq);
+}
+
+template <typename Points>
+inline unsigned exactLic10Window(const ExactPlan &plan, const Points &pts, int i) {
+    int second = i + plan.params.E_PTS + 1;
+    int third = second + plan.params.F_PTS + 1;
+    return exactAbs(exactCross(pts, i, second, third)) > plan.area1Twice;
+}
+
+template <typename Points>
+inline unsigned exactLic12Window(const ExactPlan &plan, const Points &pts, int i) {
+    ExactInt lengthSq = exactDistanceSq(pts, i, i + plan.params.K_PTS + 1);
+    return (lengthSq > plan.length1Sq) | (lengthSq < plan.length2Sq) << 1;
+}
+
+template <typename Points>
+inline unsigned exactLic13Window(const ExactPlan &plan, const Points &pts, int i) {
+    int b = i + plan.params.A_PTS + 1;
+    int c = b + plan.params.B_PTS + 1;
+    if (exactCross(pts, i, b, c) == 0) return 0;
+    return exactCircumradiusGreater(pts, i, b, c, plan.diameter1Sq) |
+           (exactCircumradiusGreater(pts, i, b, c, plan.diameter2Sq) ^ 1) << 1;
+}
+
+template <typename Points>
+inline unsigned exactLic14Window(const ExactPlan &plan, const Points &pts, int i) {
+    int second = i + plan.params.E_PTS + 1;
+    int third = second + plan.params.F_PTS + 1;
+    ExactInt area = exactAbs(exactCross(pts, i, second, third));
+    return (area > plan.area1Twice) | (area < plan.area2Twice) << 1;
+}
+
+// Flags of the window starting at point i for the LIC chosen at compile time, as in licWindowFlags
+template <int LIC, typename Points>
+inline unsigned exactWindowFlags(const ExactPlan &plan, const Points &pts, int i) {
+    const Parameters_t &params = plan.params;
+    if constexpr (LIC == 0) return exactLic0Window(plan, pts, i);
+    else if constexpr (LIC == 1) return exactLic1Window(plan, pts, i);
+    else if constexpr (LIC == 2) return exactBentAngle(plan, pts, i, i + 1, i + 2);
+    else if constexpr (LIC == 3) return exactLic3Window(plan, pts, i);
+    else if constexpr (LIC == 4) return exactLic4Window(plan, pts, i);
+    else if constexpr (LIC == 5) return pts.x(i) > pts.x(i + 1);
+    else if constexpr (LIC == 6) return exactLic6Window(plan, pts, i);
+    else if constexpr (LIC == 7) return exactDistanceSq(pts, i, i + params.K_PTS + 1) > plan.length1Sq;
+    else if constexpr (LIC == 8) return exactLic8Window(plan, pts, i);
+    else if constexpr (LIC == 9) return exactBentAngle(plan, pts, i, i + params.C_PTS + 1, i + params.C_PTS + params.D_PTS + 2);
+    else if constexpr (LIC == 10) return exactLic10Window(plan, pts, i);
+    else if constexpr (LIC == 11) return pts.x(i + params.G_PTS + 1) < pts.x(i);
+    else if constexpr (LIC == 12) return exactLic12Window(plan, pts, i);
+    else if constexpr (LIC == 13) return exactLic13Window(plan, pts, i);
+    else return exactLic14Window(plan, pts, i);
+}
+
+// Compute the CMV of fixed-point points, coordinates must be within EXACT_COORD_LIMIT
+std::array<bool, 15> computeExactCMV(const ExactPlan &plan, const int32_t *X, const int32_t *Y, int numPoints);
+std::array<bool, 15> computeExactCMV(const ExactPlan &plan, const int64_t *X, const int64_t *Y, int numPoints);
+
+#endif
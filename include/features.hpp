@@ -0,0 +1,74 @@
+#ifndef FEATURES_H
+#define FEATURES_H
+
+#include "kernels.hpp"
+#include <cstdint>
+#include <vector>
+
+// Most distinct point lags one parameter set uses: 1, K+1, A+1, B+1, A+B+2, C+1, D+1
+const int FEATURE_MAX_LAGS = 7;
+
+// Columns are aligned to this many bytes
+const int FEATURE_ALIGNMENT = 64;
+
+// Point deltas at one lag: dx[i] = X[i+lag] - X[i], dy likewise, normSq[i] = dx[i]^2 + dy[i]^2
+typedef struct {
+    int lag;
+    const double *dx;
+    const double *dy;
+    const double *normSq;
+} LagColumns;
+
+/*
+ * Per-point facts of a point set, extracted once and shared by every LIC: the quadrant code of
+ * each point, the deltas and squared norms at each point lag the parameters use, and the per-window
+ * triangles and areas of LICs 8/13 and 10/14. Every column is computed with the same expressions
+ * as the window predicates, so a CMV computed from the columns is identical to computeCMV.
+ * Storage only grows, so rebuilding for a point set no larger than capacity() does not allocate.
+ */
+class FeatureColumns {
+public:
+    explicit FeatureColumns(int maxPoints = 0);
+
+    // Grow the storage to hold the columns of point sets of maxPoints points
+    void reserve(int maxPoints);
+
+    // Largest point set build() handles without allocating
+    int capacity() const;
+
+    // Extract the columns of the points of params for the separations of params
+    void build(const Parameters_t &params);
+
+    int numPoints() const { return points; }
+    const double *X() const { return x; }
+    const double *Y() const { return y; }
+
+    // Quadrant of each point as in LIC 4
+    const uint8_t *quadrants() const { return quadrant.data(); }
+
+    // Columns at a lag the parameters use, nullptr for any other lag
+    const LagColumns *lag(int lag) const;
+
+    // separatedTriangle and separatedTriangleArea of each window of LICs 8/13 and 10/14
+    const WindowTriangle<> *triangles() const { return triangle.data(); }
+    const double *areas() const { return area.data(); }
+
+private:
+    int points = 0;
+    int capacityPoints = 0;
+    const double *x = nullptr;
+    const double *y = nullptr;
+    int lagCount = 0;
+    LagColumns lags[FEATURE_MAX_LAGS] = {};
+    std::vector<double> storage;    // 3 columns per lag, each starting on FEATURE_ALIGNMENT
+    std::vector<uint8_t> quadrant;
+    std::vector<WindowTriangle<>> triangle;
+    std::vector<double> area;
+};
+
+// CMV read from the columns of a point set built with the same params, identical to computeCMV.
+// kernels, the LicKernel of each LIC such as those of a DecidePlan, evaluate the LICs no column holds
+std::array<bool, 15> computeCMV(const FeatureColumns &features, const Parameters_t &params,
+                                const LicKernel *kernels = nullptr);
+
+#endif
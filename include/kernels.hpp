@@ -0,0 +1,87 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "decide.hpp"
+#include "lcm.hpp"
+#include "lic_windows.hpp"
+
+// Windows evaluated between two early exit checks in the fixed kernels
+static const int KERNEL_BLOCK = 16;
+
+/*
+ * Parameters_t whose separations are compile-time constants. The static members hide the fields
+ * of Parameters_t, so window predicates instantiated with this type see constants instead of
+ * loads. A LIC only reads its own separations: S1 is its first one (Q_PTS, N_PTS, K_PTS, A_PTS,
+ * C_PTS, E_PTS or G_PTS) and S2 its second one (B_PTS, D_PTS or F_PTS).
+ */
+template <int S1, int S2>
+struct FixedSeparations : Parameters_t {
+    static constexpr int Q_PTS = S1, N_PTS = S1, K_PTS = S1, G_PTS = S1;
+    static constexpr int A_PTS = S1, C_PTS = S1, E_PTS = S1;
+    static constexpr int B_PTS = S2, D_PTS = S2, F_PTS = S2;
+
+    explicit FixedSeparations(const Parameters_t &params) : Parameters_t(params) {}
+};
+
+/*
+ * Scans windows [first, last) in blocks of KERNEL_BLOCK without exits inside a block, so the
+ * block loop has a fixed trip count the compiler can unroll and vectorise.
+ */
+template <int LIC, typename Params, typename Points>
+inline unsigned licScanBlocks(const Params &params, const Points &pts, int first, int last) {
+    const unsigned required = licRequiredFlags(LIC);
+    unsigned flags = 0;
+    int i = first;
+    for (; i + KERNEL_BLOCK <= last; i += KERNEL_BLOCK) {
+        unsigned blockFlags = 0;
+        for (int k = 0; k < KERNEL_BLOCK; k++) {
+            blockFlags |= licWindowFlags<LIC>(params, pts, i + k);
+        }
+        flags |= blockFlags;
+        if (flags == required) return flags;
+    }
+    return flags | licScanWindows<LIC>(params, pts, i, last);
+}
+
+// LIC kernel specialised for separations S1 and S2, params must hold the same separations
+template <int LIC, int S1, int S2>
+bool fixedLic(const Parameters_t &params) {
+    FixedSeparations<S1, S2> fixed(params);
+    ArrayPoints pts = {params.X, params.Y};
+    return licScanBlocks<LIC>(fixed, pts, 0, licWindowCount(LIC, params)) == licRequiredFlags(LIC);
+}
+
+// True if X[i] > X[i + lag] for some i in [0, count), the test of LIC 5 (lag 1) and LIC 11 (lag G_PTS + 1)
+bool anyDescendingPair(const double *X, int lag, int count);
+
+// Function evaluating one LIC
+typedef bool (*LicKernel)(const Parameters_t &params);
+
+// Kernel for a LIC: specialised for the separations in params when they are common, runtime otherwise
+LicKernel selectLicKernel(int lic, const Parameters_t &params);
+
+// True if selectLicKernel has a specialisation for the separations in params
+bool hasFixedLicKernel(int lic, const Parameters_t &params);
+
+// Parameters, LIC kernels and launch configuration resolved once for a mission profile
+typedef struct {
+    Parameters_t params;        // Thresholds and separations, points are supplied per call
+    LicKernel kernels[15];      // Kernel chosen for each LIC
+    SparseLCM LCM;              // Used connectors
+    std::array<bool, 15> PUV;   // Preliminary Unlocking Vector
+} DecidePlan;
+
+// Resolve the kernels for the separations in params, with no connectors and an all false PUV
+DecidePlan makeDecidePlan(const Parameters_t &params);
+
+// Resolve the kernels for the separations in params and the used connectors of a symmetric LCM
+DecidePlan makeDecidePlan(const Parameters_t &params, const std::array<std::array<Connectors, 15>, 15> &LCM, std::array<bool, 15> PUV);
+
+// Compute the CMV of a point set with the kernels of a plan
+std::array<bool, 15> computeCMV(const DecidePlan &plan, const double *X, const double *Y, int numPoints);
+
+// Compute the CMV of points stored as T (float or double), every LIC computes in T
+template <typename T>
+std::array<bool, 15> computeCMV(const Parameters_t &params, const T *X, const T *Y, int numPoints);
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef LCM_H
+#define LCM_H
+
+#include "decide.hpp"
+#include <vector>
+
+// LCM and PUV of a mission, usable in constant expressions
+typedef struct {
+    Connectors LCM[15][15];     // Logical Connector Matrix
+    bool PUV[15];               // Preliminary Unlocking Vector
+} LaunchConfig;
+
+/*
+ * Launch decision of a LaunchConfig folded into masks over the CMV bits. Launch requires all bits
+ * in `required`, and for every i with eitherOf[i] != 0 it requires bit i or all bits in eitherOf[i].
+ * This is the PUM/FUV logic with the ANDD connectors merged into one mask and the ORR connectors
+ * of row i grouped, which leaves a handful of mask tests for a typical mission.
+ */
+typedef struct {
+    uint16_t required;
+    uint16_t eitherOf[15];
+} FoldedLaunch;
+
+// LaunchConfig with every connector NOTUSED and every PUV entry false
+constexpr LaunchConfig unusedLaunchConfig() {
+    LaunchConfig config = {};
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            config.LCM[i][j] = NOTUSED;
+        }
+        config.PUV[i] = false;
+    }
+    return config;
+}
+
+// Set the connector between LICs i and j, keeping the LCM symmetric
+constexpr void connectLics(LaunchConfig &config, int i, int j, Connectors op) {
+    config.LCM[i][j] = op;
+    config.LCM[j][i] = op;
+}
+
+// LaunchConfig from the arrays taken by generatePreliminaryUnlockingMatrix/generateFinalUnlockingVector
+constexpr LaunchConfig toLaunchConfig(const std::array<std::array<Connectors, 15>, 15> &LCM, const std::array<bool, 15> &PUV) {
+    LaunchConfig config = {};
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            config.LCM[i][j] = LCM[i][j];
+        }
+        config.PUV[i] = PUV[i];
+    }
+    return config;
+}
+
+// True if LCM[i][j] == LCM[j][i] for all i, j
+constexpr bool isSymmetricLCM(const LaunchConfig &config) {
+    for (int i = 0; i < 15; i++) {
+        for (int j = i + 1; j < 15; j++) {
+            if (config.LCM[i][j] != config.LCM[j][i]) return false;
+        }
+    }
+    return true;
+}
+
+// True if every connector is NOTUSED, ORR or ANDD and the diagonal is NOTUSED
+constexpr bool hasValidConnectors(const LaunchConfig &config) {
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            Connectors op = config.LCM[i][j];
+            if (op != NOTUSED && op != ORR && op != ANDD) return false;
+            if (i == j && op != NOTUSED) return false;
+        }
+    }
+    return true;
+}
+
+/** foldLaunchConfig
+ * Folds the PUM and FUV stages of a LaunchConfig into a FoldedLaunch. Only rows selected by the PUV
+ * contribute: an ANDD connector requires both LICs, an ORR connector in row i requires LIC i or the
+ * other LIC. Clauses already implied by `required` are dropped.
+ *
+ * @param config LaunchConfig, the diagonal is ignored like in generatePreliminaryUnlockingMatrix
+ *
+ * @return FoldedLaunch equivalent to launchDecision(generateFinalUnlockingVector(...))
+ */
+constexpr FoldedLaunch foldLaunchConfig(const LaunchConfig &config) {
+    FoldedLaunch folded = {};
+    for (int i = 0; i < 15; i++) {
+        if (!config.PUV[i]) continue;
+        for (int j = 0; j < 15; j++) {
+            if (i == j) continue;
+            if (config.LCM[i][j] == ANDD) folded.required |= (1u << i) | (1u << j);
+            if (config.LCM[i][j] == ORR) folded.eitherOf[i] |= 1u << j;
+        }
+    }
+    for (int i = 0; i < 15; i++) {
+        // "i or j" always holds when i or j is required anyway
+        if (folded.required >> i & 1) folded.eitherOf[i] = 0;
+        folded.eitherOf[i] &= ~folded.required;
+    }
+    return folded;
+}
+
+// Launch decision of a FoldedLaunch for a CMV bitmask
+constexpr bool foldedLaunchDecision(const FoldedLaunch &folded, uint16_t cmv) {
+    if ((cmv & folded.required) != folded.required) return false;
+    for (int i = 0; i < 15; i++) {
+        uint16_t either = folded.eitherOf[i];
+        if (either != 0 && !(cmv >> i & 1) && (cmv & either) != either) return false;
+    }
+    return true;
+}
+
+/*
+ * Launch decision for a LaunchConfig known at compile time. The config is checked and folded
+ * during compilation, so a call is the mask tests of foldedLaunchDecision with constant masks.
+ *
+ *     static constexpr LaunchConfig MISSION = ...;
+ *     bool launch = launchFor<MISSION>(cmvToMask(CMV));
+ */
+template <const LaunchConfig &CONFIG>
+inline bool launchFor(uint16_t cmv) {
+    static_assert(isSymmetricLCM(CONFIG), "LCM must be symmetric");
+    static_assert(hasValidConnectors(CONFIG), "LCM holds an unknown connector or a used diagonal entry");
+    constexpr FoldedLaunch folded = foldLaunchConfig(CONFIG);
+    return foldedLaunchDecision(folded, cmv);
+}
+
+// Entries above the diagonal of the LCM, the only ones a symmetric LCM needs
+static const int LCM_PAIRS = 105;
+
+// Index of the pair i < j among the LCM_PAIRS entries, row by row
+constexpr int lcmPairIndex(int i, int j) {
+    return i * 15 - i * (i + 1) / 2 + (j - i - 1);
+}
+
+// Symmetric LCM packed 2 bits per entry above the diagonal: 0 NOTUSED, 1 ORR, 2 ANDD
+typedef struct {
+    uint64_t words[4];          // Pair p is in bits 2 * (p % 32) of words[p / 32]
+} PackedLCM;
+
+// A connector other than NOTUSED between LICs i < j
+typedef struct {
+    uint8_t i;
+    uint8_t j;
+    uint8_t op;                 // 1 ORR, 2 ANDD, as in PackedLCM
+} LcmEntry;
+
+// Symmetric LCM as the list of its used connectors
+typedef struct {
+    int count;                  // Entries in use
+    LcmEntry entries[LCM_PAIRS];
+} SparseLCM;
+
+// Pack the upper triangle of a symmetric LCM
+PackedLCM packLCM(const std::array<std::array<Connectors, 15>, 15> &LCM);
+
+// Connector between LICs i and j of a packed LCM, NOTUSED on the diagonal
+Connectors packedConnector(const PackedLCM &packed, int i, int j);
+
+// Full symmetric LCM from a packed one
+std::array<std::array<Connectors, 15>, 15> unpackLCM(const PackedLCM &packed);
+
+// List the used connectors of a packed LCM
+SparseLCM sparseLCM(const PackedLCM &packed);
+
+// Generate PUM visiting only the used connectors
+std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::array<bool, 15> CMV, const SparseLCM &LCM);
+
+// Generate FUV straight from the CMV, visiting only the used connectors
+std::array<bool, 15> generateFinalUnlockingVector(std::array<bool, 15> CMV, const SparseLCM &LCM, std::array<bool, 15> PUV);
+
+// Launch decision from a partly known CMV: 1 or 0 if the unknown entries cannot change it, else -1
+int settledLaunch(uint16_t known, uint16_t CMV, const SparseLCM &LCM, std::array<bool, 15> PUV);
+
+// Configurations sharing one machine word in ConfigBatch
+static const int CONFIGS_PER_WORD = 64;
+
+/*
+ * Many LCM/PUV configurations stored bit-sliced: for every LCM pair there is one word saying which
+ * of 64 configurations use ORR there and one saying which use ANDD, and one word per PUV entry.
+ * One pass over the 105 pairs then decides 64 configurations against a CMV.
+ */
+class ConfigBatch {
+public:
+    // Add a configuration, returns its index in the result of launchDecisions()
+    int add(const PackedLCM &LCM, std::array<bool, 15> PUV);
+
+    // Number of configurations in the batch
+    int size() const;
+
+    // Launch decision of every configuration for a CMV bitmask, configuration c is bit c % 64 of word c / 64
+    std::vector<uint64_t> launchDecisions(uint16_t cmv) const;
+
+private:
+    typedef struct {
+        uint64_t orr[LCM_PAIRS];
+        uint64_t andd[LCM_PAIRS];
+        uint64_t puv[15];
+    } ConfigSlice;
+
+    std::vector<ConfigSlice> slices;
+    int count = 0;
+};
+
+#endif
@@ -0,0 +1,452 @@
+#ifndef LIC_WINDOWS_H
+#define LIC_WINDOWS_H
+
+#include "decide.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/*
+ * Every LIC scans a sequence of "windows": the window starting at point i is the set of points
+ * the LIC looks at for that i (a pair, a triangle, N_PTS consecutive points...). The functions
+ * in this file evaluate a single window and return its flags. Bit 0 is the condition of the LIC,
+ * LICs 12-14 raise bit 1 for their second condition. A LIC is true once all of its required flags
+ * have been raised by some window. The points are read through an accessor with x(i) and y(i)
+ * so the same predicates serve plain arrays, interleaved track storage and chunk buffers. The
+ * parameters are a template too, so a type holding the separations as compile-time constants
+ * (see kernels.hpp) gets the index arithmetic folded away. Each window computes in the scalar type
+ * the accessor returns, so float points get float arithmetic and floatCompare; thresholds from
+ * the parameters are converted to that type before comparing.
+ */
+
+// Points stored as two coordinate arrays, as in Parameters_t
+struct ArrayPoints {
+    const double *X;
+    const double *Y;
+    double x(int i) const { return X[i]; }
+    double y(int i) const { return Y[i]; }
+};
+
+// Points stored as two float coordinate arrays
+struct FloatPoints {
+    const float *X;
+    const float *Y;
+    float x(int i) const { return X[i]; }
+    float y(int i) const { return Y[i]; }
+};
+
+// Scalar type of the coordinates returned by a points accessor
+template <typename Points>
+using PointScalar = typename std::decay<decltype(std::declval<const Points &>().x(0))>::type;
+
+// Flags a LIC needs before it is true
+inline unsigned licRequiredFlags(int lic) {
+    return lic >= 12 ? 3u : 1u;
+}
+
+// Quadrant of a point as used by LIC 4, ties go to the lower quadrant number
+template <typename T>
+inline int pointQuadrant(T x, T y) {
+    if (y >= 0) return x >= 0 ? 0 : 1;
+    return x <= 0 ? 2 : 3;
+}
+
+// Distance between points i and i + 1 as computed by LICs 0 and 1
+template <typename Points>
+inline PointScalar<Points> consecutiveDistance(const Points &pts, int i) {
+    //pythagoran theorem
+    PointScalar<Points> dx = pts.x(i+1) - pts.x(i), dy = pts.y(i+1) - pts.y(i);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// LIC 0 flags for a consecutive distance
+template <typename Params, typename T>
+inline unsigned lic0Flags(const Params &params, T distance) {
+    return scalarCompare(distance, T(params.LENGTH1)) == GT;
+}
+
+// LIC 0: two consecutive points further apart than LENGTH1
+template <typename Params, typename Points>
+inline unsigned lic0Window(const Params &params, const Points &pts, int i) {
+    return lic0Flags(params, consecutiveDistance(pts, i));
+}
+
+// LIC 1 flags for a consecutive distance
+template <typename Params, typename T>
+inline unsigned lic1Flags(const Params &params, T distance) {
+    return distance > T(2 * params.RADIUS1);
+}
+
+// LIC 1: two consecutive points that cannot fit in a circle of RADIUS1
+template <typename Params, typename Points>
+inline unsigned lic1Window(const Params &params, const Points &pts, int i) {
+    return lic1Flags(params, consecutiveDistance(pts, i));
+}
+
+// LIC 2 flags for the vectors from the middle point to the other two points and their lengths
+template <typename Params, typename T>
+inline unsigned lic2Flags(const Params &params, T vector1_x, T vector1_y, T vector2_x, T vector2_y, T magnitude1, T magnitude2) {
+    // Skip points that coincide with the vertex
+    if (magnitude1 == 0 || magnitude2 == 0) return 0;
+
+    T dot_product = (vector1_x * vector2_x + vector1_y * vector2_y);
+    T cos_theta = dot_product / (magnitude1 * magnitude2);
+
+    // Clamp cos_theta to [-1, 1] to account for floating-point precision errors
+    cos_theta = std::max(T(-1), std::min(T(1), cos_theta));
+
+    T angle = std::acos(cos_theta);
+    return angle < T(M_PI - params.EPSILON) || angle > T(M_PI + params.EPSILON);
+}
+
+// LIC 2: three consecutive points forming an angle outside [PI - EPSILON, PI + EPSILON]
+template <typename Params, typename Points>
+inline unsigned lic2Window(const Params &params, const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    // Vectors from the middle point to the other two points
+    T vector1_x = pts.x(i) - pts.x(i+1);
+    T vector1_y = pts.y(i) - pts.y(i+1);
+    T vector2_x = pts.x(i+2) - pts.x(i+1);
+    T vector2_y = pts.y(i+2) - pts.y(i+1);
+
+    T magnitude1 = std::sqrt(vector1_x * vector1_x + vector1_y * vector1_y);
+    T magnitude2 = std::sqrt(vector2_x * vector2_x + vector2_y * vector2_y);
+    return lic2Flags(params, vector1_x, vector1_y, vector2_x, vector2_y, magnitude1, magnitude2);
+}
+
+// Area of the triangle of points i, i + 1 and i + 2 as computed by LIC 3
+template <typename Points>
+inline PointScalar<Points> consecutiveTriangleArea(const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    // determinant formula: https://www.cuemath.com/geometry/area-of-triangle-in-determinant-form/
+    return T(0.5) * std::abs(
+        pts.x(i) * (pts.y(i+1) - pts.y(i+2)) +
+        pts.x(i+1) * (pts.y(i+2) - pts.y(i)) +
+        pts.x(i+2) * (pts.y(i) - pts.y(i+1)));
+}
+
+// LIC 3: three consecutive points forming a triangle with area larger than AREA1
+template <typename Params, typename Points>
+inline unsigned lic3Window(const Params &params, const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    return scalarCompare(consecutiveTriangleArea(pts, i), T(params.AREA1)) == GT;
+}
+
+// LIC 4: Q_PTS consecutive points spread over more than QUADS quadrants
+template <typename Params, typename Points>
+inline unsigned lic4Window(const Params &params, const Points &pts, int j) {
+    unsigned quads = 0;
+    for (int i = j; i < j + params.Q_PTS; i++) {
+        quads |= 1u << pointQuadrant(pts.x(i), pts.y(i));
+    }
+    int count = (quads & 1) + (quads >> 1 & 1) + (quads >> 2 & 1) + (quads >> 3 & 1);
+    return params.QUADS < count;
+}
+
+// LIC 5: two consecutive points where X decreases
+template <typename Params, typename Points>
+inline unsigned lic5Window(const Params &, const Points &pts, int i) {
+    return pts.x(i) > pts.x(i+1);
+}
+
+// LIC 6: a point of N_PTS consecutive points further than DIST from the line through the first and last
+template <typename Params, typename Points>
+inline unsigned lic6Window(const Params &params, const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    int last = i + params.N_PTS - 1;
+    T dist = T(params.DIST);
+
+    // If both edge pos are same, calculate distance from point
+    if (scalarCompare(pts.x(i), pts.x(last)) == EQ && scalarCompare(pts.y(i), pts.y(last)) == EQ) {
+        for (int j = i + 1; j < last; j++) {
+            T dx = pts.x(j) - pts.x(i), dy = pts.y(j) - pts.y(i);
+            T distance = std::sqrt(dx * dx + dy * dy);
+            if (scalarCompare(distance, dist) == GT) return 1;
+        }
+        return 0;
+    }
+
+    // https://en.wikipedia.org/wiki/Distance_from_a_point_to_a_line
+    T a = pts.y(last) - pts.y(i);
+    T b = pts.x(last) - pts.x(i);
+    T c = pts.x(last) * pts.y(i) - pts.y(last) * pts.x(i);
+    T denom = std::sqrt(a * a + b * b);
+
+    for (int j = i + 1; j < last; j++) {
+        T distance = std::fabs((a * pts.x(j) - b * pts.y(j) + c) / denom);
+        if (scalarCompare(distance, dist) == GT) return 1;
+    }
+    return 0;
+}
+
+// LIC 7 flags for the distance between the two points
+template <typename Params, typename T>
+inline unsigned lic7Flags(const Params &params, T dst) {
+    return scalarCompare(dst, T(params.LENGTH1)) == GT;
+}
+
+// Distance between points i and i + K_PTS + 1 as computed by LIC 7
+template <typename Params, typename Points>
+inline PointScalar<Points> separatedDistance(const Params &params, const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    int j = i + params.K_PTS + 1;
+    T dx = pts.x(j) - pts.x(i), dy = pts.y(j) - pts.y(i);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// LIC 7: two points separated by K_PTS points further apart than LENGTH1
+template <typename Params, typename Points>
+inline unsigned lic7Window(const Params &params, const Points &pts, int i) {
+    return lic7Flags(params, separatedDistance(params, pts, i));
+}
+
+// Circumradius of the triangle abc, or 0 if the points are (nearly) collinear
+template <typename T>
+inline T triangleCircumradius(T ax, T ay, T bx, T by, T cx, T cy, T ab, T ac, T bc) {
+    // https://artofproblemsolving.com/wiki/index.php/Circumradius
+    // https://www.cuemath.com/geometry/area-of-triangle-in-coordinate-geometry/
+    T area = std::fabs(ax * (by-cy) + bx * (cy-ay) + cx * (ay-by)) / 2;
+    if (scalarCompare(area, T(0)) == EQ) return 0;
+    return (ab * bc * ac) / (4 * area);
+}
+
+// Side lengths and circumradius of the triangle of a LIC 8 or 13 window
+template <typename T = double>
+struct WindowTriangle {
+    T ab, ac, bc;
+    T circumradius;
+};
+
+// Triangle of the points separated by A_PTS and B_PTS starting at point i
+template <typename Params, typename Points>
+inline WindowTriangle<PointScalar<Points>> separatedTriangle(const Params &params, const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    int b = i + params.A_PTS + 1;
+    int c = b + params.B_PTS + 1;
+    T ax = pts.x(i), ay = pts.y(i);
+    T bx = pts.x(b), by = pts.y(b);
+    T cx = pts.x(c), cy = pts.y(c);
+
+    WindowTriangle<T> triangle;
+    triangle.ab = std::hypot(bx - ax, by - ay);
+    triangle.ac = std::hypot(cx - ax, cy - ay);
+    triangle.bc = std::hypot(cx - bx, cy - by);
+    triangle.circumradius = triangleCircumradius(ax, ay, bx, by, cx, cy, triangle.ab, triangle.ac, triangle.bc);
+    return triangle;
+}
+
+// LIC 8 flags for the window starting at point i with its triangle already computed
+template <typename Params, typename Points, typename T>
+inline unsigned lic8Flags(const Params &params, const Points &pts, int i, const WindowTriangle<T> &triangle) {
+    int b = i + params.A_PTS + 1;
+    int c = b + params.B_PTS + 1;
+    T ax = pts.x(i), ay = pts.y(i);
+    T bx = pts.x(b), by = pts.y(b);
+    T cx = pts.x(c), cy = pts.y(c);
+    T radius = T(params.RADIUS1), diameter = T(params.RADIUS1 * 2);
+
+    T ab = triangle.ab, ac = triangle.ac, bc = triangle.bc;
+    // If distance between two points is longer than diameter, cannot be kept within circle of radius RADIUS1
+    if (ab > diameter || ac > diameter || bc > diameter) return 1;
+
+    // Check if distance between midpoints of longest side and the remaining point is within RADIUS1
+    T dist;
+    if (ab > ac && ab > bc) {
+        dist = std::hypot(cx - (ax + bx) / 2, cy - (ay + by) / 2);
+    } else if (ac > ab && ac > bc) {
+        dist = std::hypot(bx - (ax + cx) / 2, by - (ay + cy) / 2);
+    } else {
+        dist = std::hypot(ax - (bx + cx) / 2, ay - (by + cy) / 2);
+    }
+    if (scalarCompare(dist, radius) != GT) return 0;
+
+    if (triangle.circumradius == 0) return 0;
+    return scalarCompare(triangle.circumradius, radius) == GT;
+}
+
+// LIC 8: three points separated by A_PTS and B_PTS that cannot be contained in a circle of RADIUS1
+template <typename Params, typename Points>
+inline unsigned lic8Window(const Params &params, const Points &pts, int i) {
+    return lic8Flags(params, pts, i, separatedTriangle(params, pts, i));
+}
+
+// LIC 9 flags for the vectors BA and BC and their lengths, A and C do not coincide with B
+template <typename Params, typename T>
+inline unsigned lic9Flags(const Params &params, T vectBAx, T vectBAy, T vectBCx, T vectBCy, T vectBAmagnitude, T vectBCmagnitude) {
+    //https://en.wikipedia.org/wiki/Dot_product
+    T dotproduct = vectBAx * vectBCx + vectBAy * vectBCy;
+    T angle = std::acos(dotproduct/vectBAmagnitude * vectBCmagnitude); //angle in rads
+
+    if (scalarCompare(angle, T(PI - params.EPSILON)) == LT) return 1;
+    return scalarCompare(angle, T(PI + params.EPSILON)) == GT;
+}
+
+// LIC 9: three points separated by C_PTS and D_PTS forming an angle outside [PI - EPSILON, PI + EPSILON]
+template <typename Params, typename Points>
+inline unsigned lic9Window(const Params &params, const Points &pts, int i) {
+    typedef PointScalar<Points> T;
+    int A = i;
+    int B = i + params.C_PTS + 1;
+    int C = B + params.D_PTS + 1;
+
+    //continue if point A or C are EQ to point B (vertex)
+    if (scalarCompare(pts.x(A), pts.x(B)) == EQ && scalarCompare(pts.y(A), pts.y(B)) == EQ) return 0;
+    if (scalarCompare(pts.x(B), pts.x(C)) == EQ && scalarCompare(pts.y(B), pts.y(C)) == EQ) return 0;
+
+    T vectBAx = pts.x(A) - pts.x(B);
+    T vectBAy = pts.y(A) - pts.y(B);
+    T vectBCx = pts.x(C) - pts.x(B);
+    T vectBCy = pts.y(C) - pts.y(B);
+    T vectBAmagnitude = std::sqrt(vectBAx * vectBAx + vectBAy * vectBAy);
+    T vectBCmagnitude = std::sqrt(vectBCx * vectBCx + vectBCy * vectBCy);
+    return lic9Flags(params, vectBAx, vectBAy, vectBCx, vectBCy, vectBAmagnitude, vectBCmagnitude);
+}
+
+// Triangle area as computed by LICs 10 and 14
+template <typename Params, typename Points>
+inline PointScalar<Points> separatedTriangleArea(const Params &params, const Points &pts, int i) {
+    int second = i + params.E_PTS + 1;
+    int third = second + params.F_PTS + 1;
+    // determinant formula: https://www.cuemath.com/geometry/area-of-triangle-in-determinant-form/
+    return PointScalar<Points>(0.5) * std::abs(
+        pts.x(i)*(pts.y(second) - pts.y(third)) +
+        pts.x(second)*(pts.y(third)-pts.y(i)) +
+        pts.x(third)*(pts.y(i)) - pts.y(second));
+}
+
+// LIC 10 flags for a separated triangle area
+template <typename Params, typename T>
+inline unsigned lic10Flags(const Params &params, T area) {
+    return scalarCompare(area, T(params.AREA1)) == GT;
+}
+
+// LIC 10: three points separated by E_PTS and F_PTS forming a triangle larger than AREA1
+template <typename Params, typename Points>
+inline unsigned lic10Window(const Params &params, const Points &pts, int i) {
+    return lic10Flags(params, separatedTriangleArea(params, pts, i));
+}
+
+// LIC 11: two points separated by G_PTS points where X decreases
+template <typename Params, typename Points>
+inline unsigned lic11Window(const Params &params, const Points &pts, int i) {
+    return pts.x(i + params.G_PTS + 1) - pts.x(i) < 0;
+}
+
+// LIC 12 flags for the distance between the two points
+template <typename Params, typename T>
+inline unsigned lic12Flags(const Params &params, T length) {
+    unsigned flags = 0;
+    if (scalarCompare(length, T(params.LENGTH1)) == GT) flags |= 1;
+    if (scalarCompare(length, T(params.LENGTH2)) == LT) flags |= 2;
+    return flags;
+}
+
+// LIC 12: bit 0 if the points are further apart than LENGTH1, bit 1 if closer than LENGTH2
+template <typename Params, typename Points>
+inline unsigned lic12Window(const Params &params, const Points &pts, int i) {
+    int j = i + params.K_PTS + 1;
+    return lic12Flags(params, std::hypot(pts.x(j) - pts.x(i), pts.y(j) - pts.y(i)));
+}
+
+// LIC 13 flags for the triangle of a window
+template <typename Params, typename T>
+inline unsigned lic13Flags(const Params &params, const WindowTriangle<T> &triangle) {
+    T circumradius = triangle.circumradius;
+    if (circumradius == 0) return 0;
+
+    unsigned flags = 0;
+    if (scalarCompare(circumradius, T(params.RADIUS1)) == GT) flags |= 1; //Assuming they fit if EQ to radius
+    if (scalarCompare(circumradius, T(params.RADIUS2)) != GT) flags |= 2;
+    return flags;
+}
+
+// LIC 13: bit 0 if the points do not fit in RADIUS1, bit 1 if they fit in RADIUS2
+template <typename Params, typename Points>
+inline unsigned lic13Window(const Params &params, const Points &pts, int i) {
+    return lic13Flags(params, separatedTriangle(params, pts, i));
+}
+
+// LIC 14 flags for a separated triangle area
+template <typename Params, typename T>
+inline unsigned lic14Flags(const Params &params, T area) {
+    unsigned flags = 0;
+    if (scalarCompare(area, T(params.AREA1)) == GT) flags |= 1;
+    if (scalarCompare(area, T(params.AREA2)) == LT) flags |= 2;
+    return flags;
+}
+
+// LIC 14: bit 0 if the triangle is larger than AREA1, bit 1 if smaller than AREA2
+template <typename Params, typename Points>
+inline unsigned lic14Window(const Params &params, const Points &pts, int i) {
+    return lic14Flags(params, separatedTriangleArea(params, pts, i));
+}
+
+// Flags of the window starting at point i for the LIC chosen at compile time
+template <int LIC, typename Params, typename Points>
+inline unsigned licWindowFlags(const Params &params, const Points &pts, int i) {
+    if constexpr (LIC == 0) return lic0Window(params, pts, i);
+    else if constexpr (LIC == 1) return lic1Window(params, pts, i);
+    else if constexpr (LIC == 2) return lic2Window(params, pts, i);
+    else if constexpr (LIC == 3) return lic3Window(params, pts, i);
+    else if constexpr (LIC == 4) return lic4Window(params, pts, i);
+    else if constexpr (LIC == 5) return lic5Window(params, pts, i);
+    else if constexpr (LIC == 6) return lic6Window(params, pts, i);
+    else if constexpr (LIC == 7) return lic7Window(params, pts, i);
+    else if constexpr (LIC == 8) return lic8Window(params, pts, i);
+    else if constexpr (LIC == 9) return lic9Window(params, pts, i);
+    else if constexpr (LIC == 10) return lic10Window(params, pts, i);
+    else if constexpr (LIC == 11) return lic11Window(params, pts, i);
+    else if constexpr (LIC == 12) return lic12Window(params, pts, i);
+    else if constexpr (LIC == 13) return lic13Window(params, pts, i);
+    else return lic14Window(params, pts, i);
+}
+
+// OR of the flags of windows [first, last), stops as soon as all required flags are raised
+template <int LIC, typename Params, typename Points>
+inline unsigned licScanWindows(const Params &params, const Points &pts, int first, int last) {
+    const unsigned required = licRequiredFlags(LIC);
+    unsigned flags = 0;
+    for (int i = first; i < last; i++) {
+        flags |= licWindowFlags<LIC>(params, pts, i);
+        if (flags == required) break;
+    }
+    return flags;
+}
+
+// Runtime dispatch of licScanWindows for any points accessor
+template <typename Params, typename Points>
+inline unsigned licScanPoints(int lic, const Params &params, const Points &pts, int first, int last) {
+    switch (lic) {
+    case 0: return licScanWindows<0>(params, pts, first, last);
+    case 1: return licScanWindows<1>(params, pts, first, last);
+    case 2: return licScanWindows<2>(params, pts, first, last);
+    case 3: return licScanWindows<3>(params, pts, first, last);
+    case 4: return licScanWindows<4>(params, pts, first, last);
+    case 5: return licScanWindows<5>(params, pts, first, last);
+    case 6: return licScanWindows<6>(params, pts, first, last);
+    case 7: return licScanWindows<7>(params, pts, first, last);
+    case 8: return licScanWindows<8>(params, pts, first, last);
+    case 9: return licScanWindows<9>(params, pts, first, last);
+    case 10: return licScanWindows<10>(params, pts, first, last);
+    case 11: return licScanWindows<11>(params, pts, first, last);
+    case 12: return licScanWindows<12>(params, pts, first, last);
+    case 13: return licScanWindows<13>(params, pts, first, last);
+    case 14: return licScanWindows<14>(params, pts, first, last);
+    }
+    return 0;
+}
+
+// Number of windows a LIC scans, 0 if its input checks reject params
+int licWindowCount(int lic, const Parameters_t &params);
+
+// Offset from the first to the last point of a window
+int licWindowSpan(int lic, const Parameters_t &params);
+
+// Runtime dispatch of licScanWindows over the points in params
+unsigned licScan(int lic, const Parameters_t &params, int first, int last);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef MULTITRACK_H
+#define MULTITRACK_H
+
+#include "decide.hpp"
+#include <vector>
+
+// Number of tracks interleaved in one block, one per SIMD lane
+static const int TRACK_LANES = 8;
+
+// Up to TRACK_LANES tracks stored point by point: point i of lane l is at [i * TRACK_LANES + l].
+// Lanes shorter than maxPoints (and unused lanes) are padded with zeros.
+typedef struct {
+    int tracks;                         // Lanes in use
+    int maxPoints;                      // Points of the longest track in the block
+    int NUMPOINTS[TRACK_LANES];         // Points of each track
+    std::vector<double> X;              // Interleaved X coordinates
+    std::vector<double> Y;              // Interleaved Y coordinates
+} TrackBlock;
+
+// Many short tracks evaluated together, TRACK_LANES at a time
+class MultiTrackSet {
+public:
+    // Copy a track into the set, returns the index of its CMV in evaluate()
+    int addTrack(const double *X, const double *Y, int numPoints);
+
+    // Number of tracks in the set
+    int size() const;
+
+    // Remove all tracks
+    void clear();
+
+    // CMV bitmask of every track, all tracks share the thresholds in params (X, Y, NUMPOINTS are ignored)
+    std::vector<uint16_t> evaluate(const Parameters_t &params) const;
+
+private:
+    std::vector<TrackBlock> blocks;
+};
+
+// Evaluate all LICs for the tracks of one block, masks receives one CMV bitmask per lane in use
+void evaluateTrackBlock(const TrackBlock &block, const Parameters_t &params, uint16_t *masks);
+
+#endif
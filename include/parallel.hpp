@@ -0,0 +1,93 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "kernels.hpp"
+#include "pool.hpp"
+#include "scheduler.hpp"
+#include <atomic>
+#include <vector>
+
+// Shared flag the LIC tasks of a decision poll between blocks of windows
+class CancellationToken {
+public:
+    void cancel() { flag.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return flag.load(std::memory_order_relaxed); }
+    void reset() { flag.store(false, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+// Result of decideParallel, CMV entries of LICs stopped before finishing are false and not known
+typedef struct {
+    bool launch;
+    uint16_t known;             // Bit i set if CMV[i] was computed
+    std::array<bool, 15> CMV;
+} ParallelDecision;
+
+// Scan the windows of one LIC, polling token every KERNEL_BLOCK windows. False in completed if cancelled
+bool cancellableLic(int lic, const Parameters_t &params, const CancellationToken &token, bool &completed);
+
+/*
+ * Decides with the LICs spread over worker threads. Each worker takes the next LIC not yet started.
+ * After every finished LIC the known entries are checked with settledLaunch, and once the launch
+ * decision is fixed the token is cancelled, so LICs still running stop at their next block
+ * boundary and the rest are not started. Cancelling the token from outside stops the decision
+ * too; its launch is then false unless it was already settled.
+ */
+ParallelDecision decideParallel(const DecidePlan &plan, const double *X, const double *Y, int numPoints,
+                                int workers, CancellationToken &token);
+
+// Windows per task when decideParallel runs on a WorkStealingPool
+static const int SCHEDULER_CHUNK = 2048;
+
+// decideParallel with each LIC scan split into tasks of SCHEDULER_CHUNK windows on a pool
+ParallelDecision decideParallel(WorkStealingPool &pool, const DecidePlan &plan, const double *X, const double *Y, int numPoints,
+                                CancellationToken &token);
+
+// Result of one point set of decideBatch
+typedef struct {
+    std::array<bool, 15> CMV;
+    std::array<bool, 15> FUV;
+    bool launch;
+} BatchDecision;
+
+// Point sets per task of decideBatch, a run's results fill whole cache lines
+static const int BATCH_RUN = 64;
+
+// Decide every point set of a batch with the plan, one task per run of BATCH_RUN point sets
+void decideBatch(WorkStealingPool &pool, const DecidePlan &plan, const PointSetView *items, int count, BatchDecision *results);
+
+/*
+ * Batch of point sets copied into one PointSetPool per worker by the workers themselves. With the
+ * usual first-touch page placement each run of BATCH_RUN point sets lands on the NUMA node of the
+ * worker that copied it, which decideBatch then asks to decide it. Pin the workers of the pool to
+ * keep them on their node. One batch is placed and decided at a time.
+ */
+class BatchPlacement {
+public:
+    explicit BatchPlacement(WorkStealingPool &pool);
+
+    // Copy a batch, replacing the previous one
+    void place(const PointSetView *items, int count);
+
+    int size() const { return (int)placed.size(); }
+    const PointSetView *items() const { return placed.data(); }
+    int runs() const { return (int)homes.size(); }
+
+    // Worker that copied run r, -1 if a thread outside the pool did
+    int home(int r) const { return homes[r]; }
+
+    WorkStealingPool &workerPool() const { return pool; }
+
+private:
+    WorkStealingPool &pool;
+    std::vector<PointSetPool> pools;    // One per worker, the last one for threads outside the pool
+    std::vector<PointSetView> placed;
+    std::vector<int> homes;
+};
+
+// Decide a placed batch, each run on the worker holding its point sets
+void decideBatch(const DecidePlan &plan, const BatchPlacement &placement, BatchDecision *results);
+
+#endif
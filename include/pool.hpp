@@ -0,0 +1,68 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "decide.hpp"
+#include <cstddef>
+#include <vector>
+
+// Alignment of every coordinate column in a PointSetPool, one cache line
+static const size_t POOL_ALIGNMENT = 64;
+
+// Default block size of a PointSetPool, one transparent huge page on x86-64
+static const size_t POOL_BLOCK_BYTES = 2 << 20;
+
+// One point set stored in a PointSetPool, valid until the pool is reset or destroyed
+typedef struct {
+    double *X;
+    double *Y;
+    int NUMPOINTS;
+} PointSetView;
+
+/*
+ * Arena for the coordinates of a batch of point sets. Columns are carved out of large blocks one
+ * after the other, so the point sets of a batch sit next to each other in memory instead of in
+ * two heap allocations each. reset() only rewinds to the first block, the blocks are kept and
+ * reused by the next batch.
+ */
+class PointSetPool {
+public:
+    explicit PointSetPool(size_t blockBytes = POOL_BLOCK_BYTES);
+    ~PointSetPool();
+
+    PointSetPool(const PointSetPool &) = delete;
+    PointSetPool &operator=(const PointSetPool &) = delete;
+
+    // Columns for numPoints points, uninitialised
+    PointSetView allocate(int numPoints);
+
+    // Copy of a point set
+    PointSetView add(const double *X, const double *Y, int numPoints);
+
+    // Forget every point set, O(1)
+    void reset();
+
+    // Point sets allocated since the last reset
+    size_t size() const { return sets; }
+
+    // Blocks owned by the pool
+    size_t blockCount() const { return blocks.size(); }
+
+private:
+    typedef struct {
+        char *base;
+        size_t bytes;
+    } Block;
+
+    void *carve(size_t bytes);
+
+    size_t blockBytes;
+    std::vector<Block> blocks;
+    size_t current = 0;         // Block being filled
+    size_t offset = 0;          // Bytes used in the current block
+    size_t sets = 0;
+};
+
+// Parameters_t with the thresholds and separations of params and the points of a view
+Parameters_t withPoints(const Parameters_t &params, const PointSetView &view);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef RANGE_H
+#define RANGE_H
+
+#include "kernels.hpp"
+#include <cstdint>
+#include <vector>
+
+// Windows whose flags hold one bit, with the number of set bits before each word for O(1) queries
+typedef struct {
+    std::vector<uint64_t> words;
+    std::vector<int> rank;      // Set bits in words [0, w), one entry per word plus a final total
+} WindowBits;
+
+/*
+ * Index of the window flags of every LIC over a whole recording, for deciding on any sub-range of
+ * points. The flags of a window only depend on the points it covers, so the sub-range [lo, hi)
+ * holds exactly the windows starting in [lo, lo + count), where count is licWindowCount for
+ * hi - lo points. A LIC is true on the sub-range if each of its required flags is set in one of
+ * those windows, which the rank of a bit vector answers in constant time.
+ */
+class RangeIndex {
+public:
+    // Evaluate every window of the points in params, once
+    explicit RangeIndex(const Parameters_t &params);
+
+    int numPoints() const { return points; }
+
+    // CMV of points [lo, hi), the same as computeCMV on a copy of those points
+    std::array<bool, 15> CMV(int lo, int hi) const;
+
+    // Launch decision of points [lo, hi) with the launch configuration of plan
+    bool decide(const DecidePlan &plan, int lo, int hi) const;
+
+private:
+    Parameters_t params;
+    int points;
+    int windows[15];            // Windows indexed per LIC
+    WindowBits flags[15][2];    // Bit 0 and bit 1 of the window flags of each LIC
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include "kernels.hpp"
+#include "pool.hpp"
+#include <vector>
+
+// Result of decideRealtime
+typedef struct {
+    std::array<bool, 15> CMV;
+    std::array<bool, 15> FUV;
+    bool launch;
+} RealtimeDecision;
+
+/*
+ * Decides a point set in bounded time. Every window of every LIC that passes its input checks is
+ * evaluated, with no early exit once a LIC is known to be true, so the work depends only on the
+ * number of points and the window parameters. Nothing is allocated and nothing throws.
+ */
+RealtimeDecision decideRealtime(const DecidePlan &plan, const double *X, const double *Y, int numPoints) noexcept;
+
+// Points one window of a LIC reads at most
+long long licWindowCost(int lic, const Parameters_t &params) noexcept;
+
+// Upper bound of the work of a LIC in decideRealtime, in points read, plus one for its input check
+long long licCostBound(int lic, const Parameters_t &params, int numPoints) noexcept;
+
+// Measured worst-case time per unit of licCostBound of each LIC and of the unlocking stage
+typedef struct {
+    std::array<double, 15> nsPerUnit;
+    double stageNs;
+} WcetProfile;
+
+// Point sets of numPoints points meant to hit the slow paths: coincident, collinear, subnormal, NaN, ...
+void stressCorpus(PointSetPool &pool, int numPoints, std::vector<PointSetView> &corpus);
+
+// Largest time per unit of each LIC over every point set of a corpus, each decided repetitions times
+WcetProfile measureWcet(const DecidePlan &plan, const PointSetView *corpus, int count, int repetitions);
+
+// Worst-case execution time of decideRealtime for a plan and point count
+typedef struct {
+    std::array<long long, 15> units;    // licCostBound of each LIC
+    std::array<double, 15> licNs;
+    double totalNs;                     // Sum of the LICs and the unlocking stage
+} WcetReport;
+
+WcetReport wcetReport(const DecidePlan &plan, int numPoints, const WcetProfile &profile);
+
+// True if decideRealtime on numPoints points stays within budgetNs according to the profile
+bool fits(const DecidePlan &plan, int numPoints, const WcetProfile &profile, double budgetNs);
+
+#endif
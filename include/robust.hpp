@@ -0,0 +1,45 @@
+#ifndef ROBUST_H
+#define ROBUST_H
+
+#include "decide.hpp"
+
+/*
+ * Robust geometric predicates for the threshold tests of LICs 6, 8, 9 and 13. Each predicate is
+ * the sign of a polynomial in the input doubles. It is first evaluated in double arithmetic with a
+ * running bound on the rounding error. Only when that bound does not settle the sign is it
+ * evaluated again exactly with floating-point expansions (Shewchuk, "Adaptive Precision
+ * Floating-Point Arithmetic and Fast Robust Geometric Predicates"). Results are exact as long as no
+ * intermediate product overflows or underflows.
+ *
+ * The comparisons have no tolerance: they return the sign of the real quantity minus the
+ * threshold, so a point on the threshold compares equal and a point a rounding step away does not.
+ */
+
+// Sign of (b - a) x (c - a): 1 counterclockwise, -1 clockwise, 0 collinear
+int robustOrientation(double ax, double ay, double bx, double by, double cx, double cy);
+
+// Sign of |ab| - length, 1 for a negative length
+int robustCompareDistance(double ax, double ay, double bx, double by, double length);
+
+// Sign of |ab| - |cd|
+int robustCompareLengths(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy);
+
+// Sign of the distance from p to the line through a and b (a != b) minus dist, 1 for a negative dist
+int robustCompareLineDistance(double ax, double ay, double bx, double by, double px, double py, double dist);
+
+// Sign of the distance from p to the midpoint of ab minus radius, 1 for a negative radius
+int robustCompareMidpointDistance(double px, double py, double ax, double ay, double bx, double by, double radius);
+
+// Sign of the circumradius of abc (not collinear) minus radius, 1 for a negative radius
+int robustCompareCircumradius(double ax, double ay, double bx, double by, double cx, double cy, double radius);
+
+// Sign of sin(d - epsilon) for the deviation d of the angle avc from straight, given cos and sin of epsilon
+int robustCompareDeviation(double ax, double ay, double vx, double vy, double cx, double cy, double cosEpsilon, double sinEpsilon);
+
+// Number of predicate evaluations the error bound could not settle, since the program started
+long robustExactEvaluations();
+
+// CMV with the robust predicates for LICs 6, 8, 9 and 13, the other LICs as in computeCMV
+std::array<bool, 15> computeRobustCMV(const Parameters_t &params);
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tasks of one fork-join step, waited for together
+class TaskGroup {
+public:
+    int pending() const { return count.load(std::memory_order_acquire); }
+
+private:
+    friend class WorkStealingPool;
+    std::atomic<int> count{0};
+};
+
+// One call of run(context, index) belonging to a TaskGroup
+typedef struct {
+    void (*run)(void *context, int index);
+    void *context;
+    int index;
+    TaskGroup *group;
+} Task;
+
+/*
+ * Thread pool where every worker owns a deque of tasks. A worker pushes and pops the tasks it
+ * spawns at the back of its own deque, so related work stays on one core, and when its deque is
+ * empty it steals the oldest task from the front of another worker's deque, so a worker left
+ * with cheap tasks takes over part of the expensive ones instead of idling. Threads outside the
+ * pool spread their tasks over the deques and help run tasks while they wait for a group.
+ */
+class WorkStealingPool {
+public:
+    // pinThreads: keep worker i on CPU i modulo the CPU count, so its memory stays on one NUMA node
+    explicit WorkStealingPool(int workers, bool pinThreads = false);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    int workers() const { return (int)threads.size(); }
+
+    // Index of the calling thread among the workers of this pool, -1 for any other thread
+    int currentWorker() const;
+
+    // Queue a task of group
+    void spawn(TaskGroup &group, void (*run)(void *context, int index), void *context, int index);
+
+    // Queue a task on the deque of one worker, where it runs unless another worker steals it
+    void spawnOn(int worker, TaskGroup &group, void (*run)(void *context, int index), void *context, int index);
+
+    // Run tasks until every task of group has finished
+    void wait(TaskGroup &group);
+
+    // Call f(i) for i in [0, count) as count tasks and wait for them
+    template <typename F>
+    void parallelFor(int count, F &f) {
+        TaskGroup group;
+        for (int i = 0; i < count; i++) {
+            spawn(group, [](void *context, int index) { (*(F *)context)(index); }, &f, i);
+        }
+        wait(group);
+    }
+
+    // Tasks taken from another worker's deque since the pool started
+    long steals() const { return stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) WorkerDeque {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    bool popOwn(int worker, Task &task);
+    bool steal(int thief, Task &task);
+    bool tryRun(int worker);
+    void workerLoop(int worker, bool pinThread);
+
+    std::vector<std::unique_ptr<WorkerDeque>> deques;
+    std::vector<std::thread> threads;
+    alignas(64) std::atomic<int> queued{0};     // Every spawn and run touches it, keep it off the other lines
+    std::atomic<unsigned> nextDeque{0};
+    std::atomic<long> stolen{0};
+    std::atomic<bool> running{true};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::condition_variable progress;           // A task was queued or the last task of a group finished
+    int waiting = 0;                            // Threads sleeping in wait(), guarded by sleepLock
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "decide.hpp"
+#include "lcm.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Binary protocol of `decide --serve`. A request is a DecideRequestHeader followed by NUMPOINTS X
+ * coordinates and NUMPOINTS Y coordinates as doubles, the reply is one DecideResponse. Everything
+ * is in native byte order since the socket is local. A connection can carry any number of requests.
+ */
+static const uint32_t DECIDE_MAGIC = 0x31434544;        // "DEC1"
+
+// Status codes in DecideResponse
+typedef enum { DECIDE_OK = 0, DECIDE_BAD_MAGIC, DECIDE_TOO_MANY_POINTS, DECIDE_BAD_PARAMETERS } DecideStatus;
+
+// Default limit on NUMPOINTS, the per-connection buffers are allocated for this many points
+static const int DECIDE_MAX_POINTS = 1 << 16;
+
+typedef struct {
+    uint32_t magic;             // DECIDE_MAGIC
+    int32_t NUMPOINTS;          // Points following the header
+    double LENGTH1;
+    double RADIUS1;
+    double EPSILON;
+    double AREA1;
+    double DIST;
+    double LENGTH2;
+    double RADIUS2;
+    double AREA2;
+    int32_t Q_PTS;
+    int32_t QUADS;
+    int32_t N_PTS;
+    int32_t K_PTS;
+    int32_t A_PTS;
+    int32_t B_PTS;
+    int32_t C_PTS;
+    int32_t D_PTS;
+    int32_t E_PTS;
+    int32_t F_PTS;
+    int32_t G_PTS;
+    uint16_t PUV;               // Bit i is PUV[i]
+    uint16_t reserved;
+    PackedLCM LCM;
+} DecideRequestHeader;
+
+typedef struct {
+    uint32_t magic;             // DECIDE_MAGIC
+    int32_t status;             // DecideStatus
+    uint16_t CMV;               // Bit i is CMV[i]
+    uint16_t FUV;               // Bit i is FUV[i]
+    uint8_t launch;             // 1 if launch, else 0
+    uint8_t reserved[3];
+} DecideResponse;
+
+static_assert(sizeof(DecideRequestHeader) == 152, "request header layout is part of the protocol");
+static_assert(sizeof(DecideResponse) == 16, "response layout is part of the protocol");
+
+// Request header for the thresholds and separations in params and a launch configuration
+DecideRequestHeader makeRequestHeader(const Parameters_t &params, const PackedLCM &LCM, std::array<bool, 15> PUV);
+
+// Decide one request, X and Y hold header.NUMPOINTS points
+DecideResponse decideRequest(const DecideRequestHeader &header, const double *X, const double *Y);
+
+/*
+ * Unix domain socket server answering decide requests with a pool of worker threads. One
+ * dispatcher thread accepts connections and polls the idle ones; a connection with a request
+ * waiting is handed to a worker, which answers that one request and gives the connection back. An
+ * idle client, however long it keeps its connection open, holds no worker.
+ */
+class DecideServer {
+public:
+    DecideServer(const std::string &path, int workers, int maxPoints = DECIDE_MAX_POINTS);
+    ~DecideServer();
+
+    // Bind the socket and start the workers, false if the path is in use or the socket could not be set up
+    bool start();
+
+    // Close the socket and all connections, then wait for the workers
+    void stop();
+
+private:
+    void dispatchLoop();
+    void workerLoop();
+    bool serveRequest(int fd, std::vector<double> &X, std::vector<double> &Y);
+    void closeConnection(int fd);
+
+    std::string path;
+    int workers;
+    int maxPoints;
+    int listenFd = -1;
+    int wakeFds[2] = {-1, -1};          // Pipe waking the dispatcher when connections come back
+    std::atomic<bool> running{false};
+    std::thread dispatcher;
+    std::vector<std::thread> threads;
+    std::mutex connectionsMutex;
+    std::condition_variable requestReady;
+    std::set<int> connections;          // Every open connection
+    std::deque<int> ready;              // Connections with a request waiting, for the workers
+    std::vector<int> returned;          // Connections answered by a worker, for the dispatcher to poll again
+};
+
+// Run `decide --serve` until the process is terminated, returns only if the socket cannot be set up
+int runServer(const std::string &path, int workers);
+
+// Client side of the protocol for one connection
+class DecideClient {
+public:
+    ~DecideClient();
+
+    // Connect to a server socket, false on failure
+    bool connect(const std::string &path);
+
+    // Send a request and wait for the reply, false if the connection failed
+    bool decide(const DecideRequestHeader &header, const double *X, const double *Y, DecideResponse &response);
+
+    void close();
+
+private:
+    int fd = -1;
+};
+
+#endif
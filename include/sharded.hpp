@@ -0,0 +1,25 @@
+#ifndef SHARDED_H
+#define SHARDED_H
+
+#include "parallel.hpp"
+#include <cstddef>
+
+// Outcome of one point set of decideSharded
+typedef enum {
+    SHARD_FAILED = 0,           // Its worker process died or ran out of memory before deciding it
+    SHARD_DECIDED = 1
+} ShardStatus;
+
+/*
+ * Decides a batch in worker processes instead of threads. The coordinator copies the point sets
+ * into one POSIX shared memory segment, forks one worker per shard and waits for them. Worker k
+ * decides the runs of BATCH_RUN point sets k, k + shards, ... and writes each result and its status
+ * to a table in the same segment. A worker that crashes or exceeds its memory only loses its own
+ * point sets, which are reported as SHARD_FAILED with false results; every other entry matches
+ * decideBatch. If a worker cannot be forked, the workers already started are waited for and the
+ * call returns false without touching results or status.
+ */
+bool decideSharded(const DecidePlan &plan, const PointSetView *items, int count, int shards, BatchDecision *results,
+                   ShardStatus *status, size_t shardMemory = 0);
+
+#endif
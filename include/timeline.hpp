@@ -0,0 +1,43 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "kernels.hpp"
+#include <vector>
+
+// Stage of the decision a TimelineEvent belongs to
+typedef enum {
+    TIMELINE_CMV,
+    TIMELINE_FUV,
+    TIMELINE_LAUNCH
+} TimelineStage;
+
+// An entry turning true once the first `points` points are known, index is the LIC or FUV entry
+typedef struct {
+    int points;
+    TimelineStage stage;
+    int index;
+} TimelineEvent;
+
+/*
+ * Decisions of every prefix of a recording. Adding points only adds windows and relaxes the input
+ * checks, so each CMV entry is false up to some prefix and true from there on, and so are the FUV
+ * entries and the launch decision built from them. A prefix length of -1 means never.
+ */
+typedef struct {
+    std::array<int, 15> flagLatch[2];   // Shortest prefix with window flag bit 0 (bit 1) of a LIC set
+    std::array<int, 15> cmvLatch;       // Shortest prefix where CMV[i] is true
+    std::array<int, 15> fuvLatch;       // Shortest prefix where FUV[i] is true
+    int launchLatch;                    // Shortest prefix that launches
+    std::vector<TimelineEvent> events;  // Every latch above, by prefix length
+} DecisionTimeline;
+
+// Sweep the points once and record when each part of the decision of a plan turns true
+DecisionTimeline decisionTimeline(const DecidePlan &plan, const double *X, const double *Y, int numPoints);
+
+// CMV of the first numPoints points of the recording of a timeline
+std::array<bool, 15> timelineCMV(const DecisionTimeline &timeline, int numPoints);
+
+// Launch decision of the first numPoints points of the recording of a timeline
+bool timelineLaunch(const DecisionTimeline &timeline, int numPoints);
+
+#endif
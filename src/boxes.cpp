@@ -0,0 +1,149 @@
+#include "../include/boxes.hpp"
+#include "../include/lic_windows.hpp"
+#include <cfloat>
+
+static PointBox mergeBoxes(const PointBox &a, const PointBox &b) {
+    return {std::min(a.minX, b.minX), std::max(a.maxX, b.maxX), std::min(a.minY, b.minY), std::max(a.maxY, b.maxY)};
+}
+
+/** BoxIndex::BoxIndex
+ * Builds the boxes of every level, leaves first. A leaf with a NaN coordinate gets an infinite box
+ * so that it never bounds anything.
+ *
+ * @param params Parameters_t with the points
+ */
+BoxIndex::BoxIndex(const Parameters_t &params) : points(params.NUMPOINTS) {
+    const PointBox everything = {-INFINITY, INFINITY, -INFINITY, INFINITY};
+    std::vector<PointBox> leaves((points + BOX_BLOCK - 1) / BOX_BLOCK);
+    for (size_t b = 0; b < leaves.size(); b++) {
+        PointBox box = {INFINITY, -INFINITY, INFINITY, -INFINITY};
+        int last = std::min((int)(b + 1) * BOX_BLOCK, points);
+        for (int i = b * BOX_BLOCK; i < last; i++) {
+            double x = params.X[i], y = params.Y[i];
+            if (std::isnan(x) || std::isnan(y)) {
+                box = everything;
+                break;
+            }
+            box = mergeBoxes(box, {x, x, y, y});
+        }
+        leaves[b] = box;
+    }
+    levels.push_back(std::move(leaves));
+
+    while (levels.back().size() > 1) {
+        const std::vector<PointBox> &below = levels.back();
+        std::vector<PointBox> above((below.size() + 1) / 2);
+        for (size_t b = 0; b < above.size(); b++) {
+            above[b] = 2 * b + 1 < below.size() ? mergeBoxes(below[2 * b], below[2 * b + 1]) : below[2 * b];
+        }
+        levels.push_back(std::move(above));
+    }
+}
+
+/** BoxIndex::cover
+ * Unions the boxes of the whole blocks holding points [first, last], taking the largest aligned
+ * box that fits at each level as in a bottom-up segment tree.
+ *
+ * @param first First point, at least 0
+ * @param last Last point, at most numPoints() - 1
+ *
+ * @return PointBox containing every point in the range
+ */
+PointBox BoxIndex::cover(int first, int last) const {
+    PointBox box = {INFINITY, -INFINITY, INFINITY, -INFINITY};
+    int lo = first / BOX_BLOCK, hi = last / BOX_BLOCK + 1;
+    for (size_t level = 0; lo < hi; level++, lo >>= 1, hi >>= 1) {
+        if (lo & 1) box = mergeBoxes(box, levels[level][lo++]);
+        if (hi & 1) box = mergeBoxes(box, levels[level][--hi]);
+    }
+    return box;
+}
+
+// Largest sqrt(dx * dx + dy * dy) the points of a box can give in double arithmetic, infinite if unknown
+static double boxDiagonal(const PointBox &box) {
+    double width = box.maxX - box.minX, height = box.maxY - box.minY;
+    // Rounding is monotonic, so no pair inside the box computes a larger distance with the same formula
+    double diagonal = std::sqrt(width * width + height * height);
+    return std::isnan(diagonal) ? INFINITY : diagonal;
+}
+
+// Largest std::hypot(dx, dy) of the points of a box: hypot is within one rounding step, not monotonic
+static double boxHypot(const PointBox &box) {
+    double width = box.maxX - box.minX, height = box.maxY - box.minY;
+    double diagonal = std::hypot(width, height) * (1 + 4 * DBL_EPSILON) + 4 * DBL_TRUE_MIN;
+    return std::isnan(diagonal) ? INFINITY : diagonal;
+}
+
+/*
+ * True if a window in [first, last) has flag bit 0 set. Windows of span points are skipped by
+ * halves while the box of all the points they cover says none can reach the threshold, and scanned
+ * once at most BOX_BLOCK are left.
+ */
+template <typename CanTrigger, typename FlagsOf>
+static bool prunedSearch(const BoxIndex &boxes, int first, int last, int span, CanTrigger canTrigger, FlagsOf flagsOf) {
+    if (first >= last || !canTrigger(boxes.cover(first, last - 1 + span))) return false;
+    if (last - first <= BOX_BLOCK) {
+        for (int i = first; i < last; i++) {
+            if (flagsOf(i) & 1) return true;
+        }
+        return false;
+    }
+    int middle = first + (last - first) / 2;
+    return prunedSearch(boxes, first, middle, span, canTrigger, flagsOf) ||
+           prunedSearch(boxes, middle, last, span, canTrigger, flagsOf);
+}
+
+/** prunedLic
+ * Evaluates one of the LICs that test a distance against an upper threshold with the BoxIndex of
+ * its points. The distance of any window inside a box is at most the box diagonal, so a box whose
+ * diagonal fails the test rules out all its windows. The window tests are unchanged, so the result
+ * is the same as evaluateLic. LIC 12 also needs a window closer than LENGTH2, which a box cannot
+ * rule out, so that half is a plain scan.
+ *
+ * @param lic 0, 1, 7 or 12
+ * @param params Parameters_t with the points of boxes
+ * @param boxes BoxIndex of the points
+ *
+ * @return boolean: the LIC result
+ */
+bool prunedLic(int lic, const Parameters_t &params, const BoxIndex &boxes) {
+    ArrayPoints pts = {params.X, params.Y};
+    int count = licWindowCount(lic, params);
+    if (count <= 0) return false;
+    int span = licWindowSpan(lic, params);
+
+    switch (lic) {
+    case 0:
+        return prunedSearch(boxes, 0, count, span,
+                            [&](const PointBox &box) { return lic0Flags(params, boxDiagonal(box)) != 0; },
+                            [&](int i) { return lic0Window(params, pts, i); });
+    case 1:
+        return prunedSearch(boxes, 0, count, span,
+                            [&](const PointBox &box) { return lic1Flags(params, boxDiagonal(box)) != 0; },
+                            [&](int i) { return lic1Window(params, pts, i); });
+    case 7:
+        return prunedSearch(boxes, 0, count, span,
+                            [&](const PointBox &box) { return lic7Flags(params, boxDiagonal(box)) != 0; },
+                            [&](int i) { return lic7Window(params, pts, i); });
+    case 12: {
+        bool closer = false;
+        for (int i = 0; i < count && !closer; i++) {
+            closer = (lic12Window(params, pts, i) & 2) != 0;
+        }
+        if (!closer) return false;
+        return prunedSearch(boxes, 0, count, span,
+                            [&](const PointBox &box) { return (lic12Flags(params, boxHypot(box)) & 1) != 0; },
+                            [&](int i) { return lic12Window(params, pts, i); });
+    }
+    }
+    return evaluateLic(lic, params);
+}
+
+std::array<bool, 15> computeCMV(const BoxIndex &boxes, const Parameters_t &params) {
+    std::array<bool, 15> CMV;
+    for (int lic = 0; lic < 15; lic++) {
+        bool pruned = lic == 0 || lic == 1 || lic == 7 || lic == 12;
+        CMV[lic] = pruned ? prunedLic(lic, params, boxes) : evaluateLic(lic, params);
+    }
+    return CMV;
+}
@@ -0,0 +1,156 @@
+#include "../include/chunked.hpp"
+#include "../include/lic_windows.hpp"
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** ChunkedDecider::ChunkedDecider
+ * Works out which LICs can have windows at all and the points to keep between chunks. A LIC is
+ * evaluated while streaming if its input checks pass for a very large point set, since more
+ * points only ever relax them.
+ *
+ * @param params Parameters_t with the thresholds and separations, the points are ignored
+ * @param chunkPoints Points buffered before windows are evaluated, at least 1
+ */
+ChunkedDecider::ChunkedDecider(const Parameters_t &params, int chunkPoints)
+    : params(params), chunkPoints(std::max(chunkPoints, 1)), keep(0) {
+    Parameters_t large = params;
+    large.NUMPOINTS = INT_MAX / 2;
+    for (int lic = 0; lic < 15; lic++) {
+        span[lic] = licWindowSpan(lic, params);
+        evaluated[lic] = licWindowCount(lic, large) > 0 && span[lic] >= 0;
+        flags[lic] = 0;
+        nextWindow[lic] = 0;
+        if (evaluated[lic]) keep = std::max(keep, span[lic]);
+    }
+    X.resize(this->chunkPoints + keep);
+    Y.resize(this->chunkPoints + keep);
+}
+
+void ChunkedDecider::append(double x, double y) {
+    X[buffered] = x;
+    Y[buffered] = y;
+    buffered++;
+    total++;
+    if (buffered == (int)X.size()) process();
+}
+
+void ChunkedDecider::add(const double *X, const double *Y, long long count) {
+    while (count > 0) {
+        int run = (int)std::min(count, (long long)(this->X.size() - buffered));
+        std::memcpy(this->X.data() + buffered, X, run * sizeof(double));
+        std::memcpy(this->Y.data() + buffered, Y, run * sizeof(double));
+        buffered += run;
+        total += run;
+        X += run;
+        Y += run;
+        count -= run;
+        if (buffered == (int)this->X.size()) process();
+    }
+}
+
+void ChunkedDecider::addInterleaved(const double *XY, long long count) {
+    for (long long i = 0; i < count; i++) {
+        append(XY[2 * i], XY[2 * i + 1]);
+    }
+}
+
+/** ChunkedDecider::process
+ * Evaluates the windows of every LIC not yet latched whose last point is buffered, then moves the
+ * last `keep` points to the front of the buffer. A window not evaluated yet starts at most its
+ * span before the end of the buffer, so it is among the kept points.
+ */
+void ChunkedDecider::process() {
+    Parameters_t local = params;
+    local.NUMPOINTS = buffered;
+    local.X = X.data();
+    local.Y = Y.data();
+    ArrayPoints pts = {X.data(), Y.data()};
+
+    for (int lic = 0; lic < 15; lic++) {
+        if (!evaluated[lic] || flags[lic] == licRequiredFlags(lic)) continue;
+        int first = (int)(nextWindow[lic] - base);
+        int last = buffered - span[lic];
+        if (last <= first) continue;
+        flags[lic] |= licScanPoints(lic, local, pts, first, last);
+        nextWindow[lic] = base + last;
+    }
+
+    int drop = std::max(buffered - keep, 0);
+    std::memmove(X.data(), X.data() + drop, (buffered - drop) * sizeof(double));
+    std::memmove(Y.data(), Y.data() + drop, (buffered - drop) * sizeof(double));
+    base += drop;
+    buffered -= drop;
+}
+
+/** ChunkedDecider::finish
+ * Evaluates the windows completed by the last points, then applies the input checks for the total
+ * number of points. A LIC that passes them has exactly the windows evaluated while streaming.
+ *
+ * @return CMV of all appended points
+ */
+std::array<bool, 15> ChunkedDecider::finish() {
+    process();
+    Parameters_t counted = params;
+    counted.NUMPOINTS = (int)std::min(total, (long long)INT_MAX);
+
+    std::array<bool, 15> CMV;
+    for (int lic = 0; lic < 15; lic++) {
+        CMV[lic] = evaluated[lic] && licWindowCount(lic, counted) > 0 && flags[lic] == licRequiredFlags(lic);
+    }
+    return CMV;
+}
+
+/** chunkedCMVFromFile
+ * Maps a file of interleaved X/Y doubles and streams it through a ChunkedDecider. Pages are read
+ * sequentially and dropped once their points are buffered, so the resident part of the mapping
+ * stays around one chunk too.
+ *
+ * @param path File of 16-byte points, x then y, in native byte order
+ * @param params Parameters_t with the thresholds and separations, the points are ignored
+ * @param chunkPoints Points per chunk, values below 1 are taken as 1
+ * @param CMV Set to the CMV of the points of the file
+ *
+ * @return boolean: false if the file cannot be opened or mapped or is not a whole number of points
+ */
+bool chunkedCMVFromFile(const char *path, const Parameters_t &params, int chunkPoints, std::array<bool, 15> &CMV) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size % (2 * sizeof(double)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    chunkPoints = std::max(chunkPoints, 1);
+    ChunkedDecider decider(params, chunkPoints);
+    size_t bytes = info.st_size;
+    if (bytes > 0) {
+        void *mapping = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+        const double *XY = (const double *)mapping;
+        long long points = bytes / (2 * sizeof(double));
+        size_t page = sysconf(_SC_PAGESIZE), released = 0;
+        for (long long first = 0; first < points; first += chunkPoints) {
+            long long count = std::min((long long)chunkPoints, points - first);
+            decider.addInterleaved(XY + 2 * first, count);
+            size_t consumed = (first + count) * 2 * sizeof(double) / page * page;
+            if (consumed > released) {
+                madvise((char *)mapping + released, consumed - released, MADV_DONTNEED);
+                released = consumed;
+            }
+        }
+        munmap(mapping, bytes);
+    }
+    close(fd);
+    CMV = decider.finish();
+    return true;
+}
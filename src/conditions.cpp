@@ -0,0 +1,225 @@
+#include "../include/conditions.hpp"
+#include "../include/kernels.hpp"
+#include <algorithm>
+
+bool ConditionBits::all() const {
+    for (size_t w = 0; w < data.size(); w++) {
+        int used = std::min(64, bits - (int)w * 64);
+        uint64_t full = used == 64 ? ~uint64_t(0) : (uint64_t(1) << used) - 1;
+        if (data[w] != full) return false;
+    }
+    return true;
+}
+
+int ConditionBits::count() const {
+    int total = 0;
+    for (uint64_t word : data) total += __builtin_popcountll(word);
+    return total;
+}
+
+// Clears the bits of the last word past size()
+static void clearPadding(ConditionBits &bits) {
+    if (bits.size() % 64 != 0) bits.words().back() &= (uint64_t(1) << (bits.size() % 64)) - 1;
+}
+
+static const int licNumbers[15] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+
+// Points each LIC reads per window with small separations, the cost hints of the built-in conditions
+static const double licCosts[15] = {2, 3, 3, 3, 4, 2, 4, 2, 3, 3, 3, 2, 2, 3, 3};
+
+static bool builtinLic(const Parameters_t &params, const void *context) {
+    int lic = *(const int *)context;
+    return selectLicKernel(lic, params)(params);
+}
+
+ConditionRegistry::ConditionRegistry() {
+    for (int lic = 0; lic < 15; lic++) {
+        add("LIC" + std::to_string(lic), &builtinLic, &licNumbers[lic], licCosts[lic]);
+    }
+}
+
+int ConditionRegistry::add(const std::string &name, ConditionFunction evaluate, const void *context, double cost) {
+    conditions.push_back({name, evaluate, context, cost});
+    int number = (int)conditions.size() - 1;
+    auto cheaper = [&](int a, int b) { return conditions[a].cost < conditions[b].cost; };
+    order.insert(std::upper_bound(order.begin(), order.end(), number, cheaper), number);
+    return number;
+}
+
+int ConditionRegistry::find(const std::string &name) const {
+    for (int i = 0; i < size(); i++) {
+        if (conditions[i].name == name) return i;
+    }
+    return -1;
+}
+
+ConditionBits ConditionRegistry::computeCMV(const Parameters_t &params) const {
+    ConditionBits CMV(size());
+    for (int i = 0; i < size(); i++) {
+        CMV.set(i, conditions[i].evaluate(params, conditions[i].context));
+    }
+    return CMV;
+}
+
+UnlockingLogic::UnlockingLogic(int conditions)
+    : andRows(conditions, ConditionBits(conditions)), orRows(conditions, ConditionBits(conditions)), puv(conditions) {}
+
+UnlockingLogic::UnlockingLogic(const std::array<std::array<Connectors, 15>, 15> &LCM, std::array<bool, 15> PUV)
+    : UnlockingLogic(15) {
+    for (int row = 0; row < 15; row++) {
+        for (int column = 0; column < 15; column++) setConnector(row, column, LCM[row][column]);
+        setPUV(row, PUV[row]);
+    }
+}
+
+void UnlockingLogic::setConnector(int row, int column, Connectors connector) {
+    if (row == column) return;
+    andRows[row].set(column, connector == ANDD);
+    orRows[row].set(column, connector == ORR);
+}
+
+Connectors UnlockingLogic::connector(int row, int column) const {
+    if (andRows[row].test(column)) return ANDD;
+    if (orRows[row].test(column)) return ORR;
+    return NOTUSED;
+}
+
+/** UnlockingLogic::PUMRow
+ * Computes one row of the PUM a word at a time. With CMV[i] true an ANDD entry is CMV[j] and every
+ * other entry is true; with CMV[i] false an ANDD entry is false, an ORR entry is CMV[j] and a
+ * NOTUSED entry is true.
+ *
+ * @param CMV Conditions Met Vector, size() bits
+ * @param i Row
+ *
+ * @return ConditionBits: row i of the PUM, entry i set
+ */
+ConditionBits UnlockingLogic::PUMRow(const ConditionBits &CMV, int i) const {
+    ConditionBits row(size());
+    const std::vector<uint64_t> &ands = andRows[i].words(), &ors = orRows[i].words(), &met = CMV.words();
+    std::vector<uint64_t> &out = row.words();
+    if (CMV.test(i)) {
+        for (size_t w = 0; w < out.size(); w++) out[w] = ~ands[w] | met[w];
+    } else {
+        for (size_t w = 0; w < out.size(); w++) out[w] = ~(ands[w] | ors[w]) | (ors[w] & met[w]);
+    }
+    row.set(i);
+    clearPadding(row);
+    return row;
+}
+
+std::vector<ConditionBits> UnlockingLogic::PUM(const ConditionBits &CMV) const {
+    std::vector<ConditionBits> rows;
+    rows.reserve(size());
+    for (int i = 0; i < size(); i++) rows.push_back(PUMRow(CMV, i));
+    return rows;
+}
+
+// True if every entry of PUM row i is true, the entries of PUMRow tested a word at a time without building the row
+bool UnlockingLogic::rowTrue(const ConditionBits &CMV, int i) const {
+    const std::vector<uint64_t> &ands = andRows[i].words(), &ors = orRows[i].words(), &met = CMV.words();
+    bool self = CMV.test(i);
+    for (size_t w = 0; w < met.size(); w++) {
+        // Entries that are false: connected by ANDD to a false condition, or by ORR when both are false
+        uint64_t failing = self ? ands[w] & ~met[w] : ands[w] | (ors[w] & ~met[w]);
+        if (failing != 0) return false;
+    }
+    return true;
+}
+
+ConditionBits UnlockingLogic::FUV(const ConditionBits &CMV) const {
+    ConditionBits FUV(size());
+    for (int i = 0; i < size(); i++) {
+        FUV.set(i, !puv.test(i) || rowTrue(CMV, i));
+    }
+    return FUV;
+}
+
+bool UnlockingLogic::launch(const ConditionBits &CMV) const {
+    for (int i = 0; i < size(); i++) {
+        if (puv.test(i) && !rowTrue(CMV, i)) return false;
+    }
+    return true;
+}
+
+/** UnlockingLogic::readConditions
+ * Collects the conditions the launch decision depends on. A row outside the PUV is never read, and
+ * a row of the PUV without connectors is all true, so only the rows of the PUV with connectors
+ * count, with the conditions they connect.
+ *
+ * @return ConditionBits: the conditions launch() reads
+ */
+ConditionBits UnlockingLogic::readConditions() const {
+    ConditionBits read(size());
+    std::vector<uint64_t> &out = read.words();
+    for (int r = 0; r < size(); r++) {
+        if (!puv.test(r)) continue;
+        uint64_t connected = 0;
+        for (size_t w = 0; w < out.size(); w++) {
+            uint64_t columns = andRows[r].words()[w] | orRows[r].words()[w];
+            out[w] |= columns;
+            connected |= columns;
+        }
+        if (connected != 0) read.set(r);
+    }
+    return read;
+}
+
+/** UnlockingLogic::settledNoLaunch
+ * Checks whether a row of the PUV already has a false PUM entry. With condition r known false, any
+ * ANDD entry of row r is false, and so is an ORR entry to a condition known false; otherwise only
+ * an ANDD entry to a condition known false is.
+ *
+ * @param known Conditions evaluated so far
+ * @param CMV Their values, bits of conditions not known are ignored
+ *
+ * @return boolean: true if the launch decision is false whatever the other conditions are
+ */
+bool UnlockingLogic::settledNoLaunch(const ConditionBits &known, const ConditionBits &CMV) const {
+    std::vector<uint64_t> knownFalse(known.words().size());
+    for (size_t w = 0; w < knownFalse.size(); w++) knownFalse[w] = known.words()[w] & ~CMV.words()[w];
+
+    for (int r = 0; r < size(); r++) {
+        if (!puv.test(r)) continue;
+        bool rowFalse = knownFalse[r >> 6] >> (r & 63) & 1;
+        const std::vector<uint64_t> &ands = andRows[r].words(), &ors = orRows[r].words();
+        for (size_t w = 0; w < knownFalse.size(); w++) {
+            uint64_t failing = rowFalse ? ands[w] | (ors[w] & knownFalse[w]) : ands[w] & knownFalse[w];
+            if (failing != 0) return true;
+        }
+    }
+    return false;
+}
+
+/** decideConditions
+ * Decides with only the conditions the unlocking logic reads: those of the rows of the PUV that have
+ * connectors, and the columns they connect to. They are evaluated in the cost order of the registry,
+ * and after each one the rows of the PUV are checked, so an expensive condition is skipped once a
+ * cheaper one already rules out the launch.
+ *
+ * @param registry ConditionRegistry of the conditions
+ * @param logic UnlockingLogic of the same size
+ * @param params Parameters_t with the points
+ * @param CMV Set to the conditions evaluated, may be nullptr
+ *
+ * @return boolean: the launch decision, the same as logic.launch(registry.computeCMV(params))
+ */
+bool decideConditions(const ConditionRegistry &registry, const UnlockingLogic &logic, const Parameters_t &params,
+                      ConditionBits *CMV) {
+    int size = registry.size();
+    ConditionBits needed = logic.readConditions(), known(size), met(size);
+
+    bool settled = false;
+    for (int i : registry.costOrder()) {
+        if (!needed.test(i)) continue;
+        const Condition &condition = registry.condition(i);
+        met.set(i, condition.evaluate(params, condition.context));
+        known.set(i);
+        if (!met.test(i) && logic.settledNoLaunch(known, met)) {
+            settled = true;
+            break;
+        }
+    }
+    if (CMV != nullptr) *CMV = met;
+    return !settled && logic.launch(met);
+}
@@ -0,0 +1,47 @@
+#include "../include/context.hpp"
+
+DecideContext::DecideContext(int maxPoints) : features(maxPoints) {}
+
+/** DecideContext::reserve
+ * Grows the feature columns to point sets of maxPoints points. Never shrinks, so a context sized
+ * for the largest point set keeps its buffers for the rest of its life.
+ *
+ * @param maxPoints Number of points the buffers must cover
+ */
+void DecideContext::reserve(int maxPoints) {
+    features.reserve(maxPoints);
+}
+
+int DecideContext::capacity() const {
+    return features.capacity();
+}
+
+/** DecideContext::decide
+ * Computes the CMV, PUM, FUV and launch decision of a point set. The feature columns are built
+ * first and every LIC reads its CMV entry from them, except LICs 3 and 6, which no column holds
+ * and which run the kernels of the plan. The only allocation is growing the buffers when
+ * numPoints exceeds capacity().
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param X X coordinates of the points
+ * @param Y Y coordinates of the points
+ * @param numPoints Number of points
+ *
+ * @return boolean: launch decision, also available from launch()
+ */
+bool DecideContext::decide(const DecidePlan &plan, const double *X, const double *Y, int numPoints) {
+    reserve(numPoints);
+
+    Parameters_t params = plan.params;
+    params.NUMPOINTS = numPoints;
+    params.X = const_cast<double *>(X);
+    params.Y = const_cast<double *>(Y);
+
+    features.build(params);
+    cmv = computeCMV(features, params, plan.kernels);
+
+    pum = generatePreliminaryUnlockingMatrix(cmv, plan.LCM);
+    fuv = generateFinalUnlockingVector(cmv, plan.LCM, plan.PUV);
+    launched = launchDecision(fuv);
+    return launched;
+}
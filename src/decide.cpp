@@ -1,4 +1,5 @@
 #include "../include/decide.hpp"
+#include "../include/lic_windows.hpp"
 #include <array>
 #include <iostream>
 
@@ -6,25 +7,165 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+/** licWindowCount
+ * Returns how many windows a LIC scans over the points in params. This is where the input checks
+ * (base cases) of every LIC live: if a LIC rejects its parameters it scans 0 windows and is false.
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with NUMPOINTS and the fields the LIC uses
+ *
+ * @return number of window start indices, the windows are [0, count)
+ */
+int licWindowCount(int lic, const Parameters_t &params) {
+    int count = 0;
+    switch (lic) {
+    case 0:
+        if (params.NUMPOINTS < 2 || params.LENGTH1 < 0) return 0;
+        count = params.NUMPOINTS - 1;
+        break;
+    case 1:
+    case 5:
+        // Not enough points to compare
+        if (params.NUMPOINTS < 2) return 0;
+        count = params.NUMPOINTS - 1;
+        break;
+    case 2:
+        // Not enough points to form an angle
+        if (params.NUMPOINTS < 3) return 0;
+        count = params.NUMPOINTS - 2;
+        break;
+    case 3:
+        if (params.NUMPOINTS < 3 || params.AREA1 < 0) return 0;
+        count = params.NUMPOINTS - 2;
+        break;
+    case 4:
+        if (params.QUADS < 1 || params.QUADS > 3 || params.Q_PTS < 2 || params.Q_PTS > params.NUMPOINTS) return 0;
+        count = params.NUMPOINTS - params.Q_PTS + 1;
+        break;
+    case 6:
+        if (params.NUMPOINTS < 3 || params.N_PTS < 3 || params.NUMPOINTS < params.N_PTS) return 0;
+        count = params.NUMPOINTS - params.N_PTS + 1;
+        break;
+    case 7:
+        if (params.LENGTH1 <= 0 || params.NUMPOINTS < 3 || params.K_PTS < 1 || params.K_PTS > params.NUMPOINTS - 2) return 0;
+        count = params.NUMPOINTS - params.K_PTS - 1;
+        break;
+    case 8:
+    case 13:
+        // Implicitly rejects NUMPOINTS < 5
+        if (params.A_PTS < 1 || params.B_PTS < 1 || (long long)params.A_PTS + params.B_PTS > params.NUMPOINTS - 3) return 0;
+        count = params.NUMPOINTS - params.A_PTS - params.B_PTS - 2;
+        break;
+    case 9:
+        if (params.C_PTS < 1 || params.D_PTS < 1 || (long long)params.C_PTS + params.D_PTS > params.NUMPOINTS - 3) return 0;
+        if (params.EPSILON > PI || params.EPSILON < 0) return 0;
+        count = params.NUMPOINTS - params.C_PTS - params.D_PTS - 2;
+        break;
+    case 10:
+        if (params.NUMPOINTS < 5 || params.E_PTS < 1 || params.F_PTS < 1 || params.AREA1 <= 0
+            || (long long)params.E_PTS + params.F_PTS > params.NUMPOINTS - 3) return 0;
+        count = params.NUMPOINTS - params.E_PTS - params.F_PTS - 2;
+        break;
+    case 11:
+        if (params.NUMPOINTS < 3 || params.G_PTS < 1 || params.G_PTS > params.NUMPOINTS - 2) return 0;
+        count = params.NUMPOINTS - params.G_PTS - 1;
+        break;
+    case 12:
+        if (params.NUMPOINTS < 3 || params.K_PTS < 1 || params.LENGTH1 < 0 || params.LENGTH2 < 0) return 0;
+        count = params.NUMPOINTS - params.K_PTS - 1;
+        break;
+    case 14:
+        // Separations of 0 and -1 keep every point inside the window, below -1 they would read before it
+        if (params.NUMPOINTS < 5 || params.E_PTS < -1 || params.F_PTS < -1 || params.AREA1 <= 0 || params.AREA2 <= 0
+            || (long long)params.E_PTS + params.F_PTS > params.NUMPOINTS - 3) return 0;
+        count = params.NUMPOINTS - params.E_PTS - params.F_PTS - 2;
+        break;
+    }
+    return count > 0 ? count : 0;
+}
+
+/** licWindowSpan
+ * Returns the offset from the first to the last point of a window of a LIC, so the window starting
+ * at i reads the points [i, i + span].
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the separations the LIC uses
+ *
+ * @return span of a window in points
+ */
+int licWindowSpan(int lic, const Parameters_t &params) {
+    switch (lic) {
+    case 0: case 1: case 5: return 1;
+    case 2: case 3: return 2;
+    case 4: return params.Q_PTS - 1;
+    case 6: return params.N_PTS - 1;
+    case 7: case 12: return params.K_PTS + 1;
+    case 8: case 13: return params.A_PTS + params.B_PTS + 2;
+    case 9: return params.C_PTS + params.D_PTS + 2;
+    case 10: case 14: return params.E_PTS + params.F_PTS + 2;
+    case 11: return params.G_PTS + 1;
+    }
+    return 0;
+}
+
+/** licScan
+ * Runtime dispatch of licScanWindows for the points in params.
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the points and the fields the LIC uses
+ * @param first First window to scan
+ * @param last One past the last window to scan, at most licWindowCount(lic, params)
+ *
+ * @return OR of the flags of the scanned windows
+ */
+unsigned licScan(int lic, const Parameters_t &params, int first, int last) {
+    ArrayPoints pts = {params.X, params.Y};
+    return licScanPoints(lic, params, pts, first, last);
+}
+
+/** evaluateLic
+ * Evaluates one LIC over all of its windows.
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the points and the fields the LIC uses
+ *
+ * @return boolean: true if the windows raised all flags the LIC requires
+ */
+bool evaluateLic(int lic, Parameters_t params) {
+    return licScan(lic, params, 0, licWindowCount(lic, params)) == licRequiredFlags(lic);
+}
 
- /**
- * Compares two double values with a precision tolerance.
+/** computeCMV
+ * Evaluates all 15 LICs into the Conditions Met Vector.
  *
- * This function compares two double values `a` and `b` to determine their
- * relative difference within a specified precision tolerance of 0.000001.
- * It returns EQ if the values are nearly equal, LT if `a` is less than `b`,
- * and GT if `a` is greater than `b`.
+ * @param params Parameters_t with the points and all LIC parameters
  *
- * @param a First double value to compare.
- * @param b Second double value to compare.
- * @return CompType Comparison result: EQ, LT, or GT.
+ * @return CMV where index i is the result of LIC i
  */
-Comptype doubleCompare (double a, double b) {
-    if (fabs(a-b) < 0.000001) return EQ;
-    if (a < b) return LT;
-    return GT;
+std::array<bool, 15> computeCMV(Parameters_t params) {
+    std::array<bool, 15> CMV;
+    for (int i = 0; i < 15; i++) {
+        CMV[i] = evaluateLic(i, params);
+    }
+    return CMV;
 }
 
+/** cmvToMask
+ * Packs a CMV into 15 bits, bit i set if CMV[i] is true.
+ *
+ * @param CMV Conditions Met Vector
+ *
+ * @return bitmask of the met conditions
+ */
+uint16_t cmvToMask(std::array<bool, 15> CMV) {
+    uint16_t mask = 0;
+    for (int i = 0; i < 15; i++) {
+        if (CMV[i]) mask |= 1u << i;
+    }
+    return mask;
+}
+
+
 /** LIC 0
 /*
  * Checks if there are two consecutive points with a distance greater than LENGTH1.
@@ -36,16 +177,8 @@ Comptype doubleCompare (double a, double b) {
  * @param params Parameters_t structure containing the number of points, their coordinates, and LENGTH1.
  * @return bool True if there are two consecutive points with a distance greater than LENGTH1, false otherwise.
  */
-bool isConsecDistGTLen(Parameters_t params){
-    if(params.NUMPOINTS < 2 || params.LENGTH1 < 0) return false;
-
-    for(int i = 0; i < params.NUMPOINTS - 1; i++){
-        //pythagoran theorem
-        double distance = sqrt(pow(params.X[i+1] - params.X[i], 2) + pow(params.Y[i+1] - params.Y[i], 2));
-        if(doubleCompare(distance, params.LENGTH1) == GT) return true;
-    }
-
-    return false;
+bool isConsecDistGTLen(Parameters_t params) {
+    return evaluateLic(0, params);
 }
 
 /* LIC 1
@@ -57,24 +190,7 @@ bool isConsecDistGTLen(Parameters_t params){
  */
 
 bool lic1(Parameters_t params) {
-    if (params.NUMPOINTS < 2) {
-        return false; // Not enough points to evaluate
-    }
-
-    for (int i = 0; i < params.NUMPOINTS - 1; ++i) {
-        double x1 = params.X[i], y1 = params.Y[i];
-        double x2 = params.X[i + 1], y2 = params.Y[i + 1];
-
-        // Calculate the distance between the two points
-        double distance = std::sqrt(std::pow(x2 - x1, 2) + std::pow(y2 - y1, 2));
-
-        // Check if the distance is greater than 2 * RADIUS1 (diameter of the circle)
-        if (distance > 2 * params.RADIUS1) {
-            return true; // Found a pair of points that cannot fit within the circle
-        }
-    }
-
-    return false; // No such pair of points found
+    return evaluateLic(1, params);
 }
 
 
@@ -88,46 +204,7 @@ bool lic1(Parameters_t params) {
  * Collinear points with an angle exactly equal to PI are ignored.
  */
 bool lic2(Parameters_t params) {
-    if (params.NUMPOINTS < 3) {
-        return false; // Not enough points to form an angle
-    }
-
-    for (int i = 0; i <= params.NUMPOINTS - 3; ++i) {
-        double x1 = params.X[i], y1 = params.Y[i];
-        double x2 = params.X[i + 1], y2 = params.Y[i + 1];
-        double x3 = params.X[i + 2], y3 = params.Y[i + 2];
-
-        // Vectors from the middle point to the other two points
-        double vector1_x = x1 - x2;
-        double vector1_y = y1 - y2;
-        double vector2_x = x3 - x2;
-        double vector2_y = y3 - y2;
-
-        // Magnitudes of the vectors
-        double magnitude1 = std::sqrt(vector1_x * vector1_x + vector1_y * vector1_y);
-        double magnitude2 = std::sqrt(vector2_x * vector2_x + vector2_y * vector2_y);
-
-        // Skip collinear points (magnitude == 0)
-        if (magnitude1 == 0 || magnitude2 == 0) {
-            continue;
-        }
-
-        // Compute the dot product and the angle
-        double dot_product = (vector1_x * vector2_x + vector1_y * vector2_y);
-        double cos_theta = dot_product / (magnitude1 * magnitude2);
-
-        // Clamp cos_theta to [-1, 1] to account for floating-point precision errors
-        cos_theta = std::max(-1.0, std::min(1.0, cos_theta));
-
-        double angle = std::acos(cos_theta); // Angle in radians
-
-        // Check if the angle is outside the range [PI - EPSILON, PI + EPSILON]
-        if (angle < (M_PI - params.EPSILON) || angle > (M_PI + params.EPSILON)) {
-            return true; // Found an angle outside the range
-        }
-    }
-
-    return false; // No such angle found
+    return evaluateLic(2, params);
 }
 
 
@@ -139,17 +216,7 @@ bool lic2(Parameters_t params) {
  * It returns true if area is greater than AREA1.
  */
 bool lic3(Parameters_t params) {
-    if(params.NUMPOINTS < 3 || params.AREA1 < 0) return false;
-
-    for(int i = 0; i < params.NUMPOINTS -2; i++){
-        // determinant formula: https://www.cuemath.com/geometry/area-of-triangle-in-determinant-form/
-        double area = 0.5 * std::abs(
-            params.X[i] * (params.Y[i+1] - params.Y[i+2]) + 
-            params.X[i+1] * (params.Y[i+2]-params.Y[i]) + 
-            params.X[i+2] * (params.Y[i] - params.Y[i+1]));
-        if(doubleCompare(area, params.AREA1) == GT) return true;
-    }
-    return false;
+    return evaluateLic(3, params);
 }
 
 /** LIC 4
@@ -168,36 +235,8 @@ bool lic3(Parameters_t params) {
  *               - Y: An array of Y-coordinates of the points.
  * @return bool True if Q_PTS consecutive points are in quadrants that are greater than QUAD
  */
-bool lic4(Parameters_t params){
-
-    if(params.QUADS < 1 || params.QUADS > 3 || params.Q_PTS < 2 || params.Q_PTS > params.NUMPOINTS) return false;
-
-    for(int j = 0; j <= params.NUMPOINTS - params.Q_PTS; j++){
-        bool quad[4] = {false, false, false, false};
-        for(int i = j; i < j + params.Q_PTS; i++){
-            if(params.Y[i] >= 0){
-                if(params.X[i] >= 0){
-                    quad[0] = true;
-                } else {
-                    quad[1] = true;
-                }
-            } else {
-                if(params.X[i] <= 0){
-                    quad[2] = true;
-                } else {
-                    quad[3] = true;
-                }
-            }
-        }
-        int count = 0;
-        for(int i = 0; i < 4; i++){
-            if(quad[i]) count++;
-        }
-        if(params.QUADS < count) return true;
-    }
-
-    return false;
-        
+bool lic4(Parameters_t params) {
+    return evaluateLic(4, params);
 }
 
 /* LIC 5
@@ -207,17 +246,7 @@ bool lic4(Parameters_t params){
  * If there are fewer than 2 points, the condition cannot be satisfied, and the function returns false. 
  */
 bool lic5(Parameters_t params) {
-    if (params.NUMPOINTS < 2) {
-        return false; // Not enough points to compare
-    }
-
-    for (int i = 0; i < params.NUMPOINTS - 1; ++i) {
-        if (params.X[i] > params.X[i + 1]) {
-            return true; // Condition satisfied
-        }
-    }
-
-    return false; // No such pair found
+    return evaluateLic(5, params);
 }
 
 
@@ -228,33 +257,7 @@ bool lic5(Parameters_t params) {
  * last of these N_PTS. If the first and last are the same, instead check distance from point. 
  */
 bool isDistFromLine(Parameters_t params) {
-    // Base Cases
-    if (params.NUMPOINTS < 3 || params.N_PTS < 3 || params.NUMPOINTS < params.N_PTS) return false;
-    for (int i = 0; i < params.NUMPOINTS - params.N_PTS + 1; i++) {
-
-        // If both edge pos are same, calculate distance from point 
-        if (doubleCompare(params.X[i], params.X[i+params.N_PTS-1]) == EQ && doubleCompare(params.Y[i], params.Y[i+params.N_PTS-1]) == EQ) {
-            for(int j = i + 1; j < i + params.N_PTS - 1; j++) {
-                // Pythagorean Theorem 
-                double distance = sqrt(pow(params.X[j] - params.X[i], 2) + pow(params.Y[j] - params.Y[i], 2));
-                
-                if (doubleCompare(distance, params.DIST) == GT) return true;
-            }
-        } else {
-            // https://en.wikipedia.org/wiki/Distance_from_a_point_to_a_line
-            double a = params.Y[i+params.N_PTS-1] - params.Y[i];
-            double b = params.X[i+params.N_PTS-1] - params.X[i];
-            double c = params.X[i+params.N_PTS-1] * params.Y[i] - params.Y[i+params.N_PTS-1] * params.X[i];
-            double denom = sqrt(pow(params.Y[i+params.N_PTS-1] - params.Y[i], 2) + pow(params.X[i+params.N_PTS-1] - params.X[i], 2));
-
-            for(int j = i + 1; j < i + params.N_PTS - 1; j++) {
-                double distance = fabs((a * params.X[j] - b * params.Y[j] + c) / denom);
-                if (doubleCompare(distance, params.DIST) == GT) return true;
-            }
-        }
-    }
-    // Only reached if no point matches the requirements
-    return false;
+    return evaluateLic(6, params);
 }
 
 // LIC 7
@@ -263,17 +266,9 @@ bool isDistFromLine(Parameters_t params) {
  * two points with a distance larger than LENGTH1 between them and returns true, or untill it has iterated 
  * through all possible pairs of points separated by K_PTS and returns false.
  */
- bool lic7(Parameters_t params) {
-    if(params.LENGTH1 <= 0 || params.NUMPOINTS <3 || params.K_PTS < 1 || params.K_PTS > params.NUMPOINTS - 2) return false;
-
-    for(int i = 0; i < params.NUMPOINTS - params.K_PTS - 1; i++){
-        // https://www.khanacademy.org/math/geometry/hs-geo-analytic-geometry/hs-geo-distance-and-midpoints/v/distance-formula
-        // d=√((x_2-x_1)²+(y_2-y_1)²)
-        double dst = sqrt(pow(params.X[i + params.K_PTS + 1] - params.X[i], 2) + pow(params.Y[i + params.K_PTS + 1] - params.Y[i], 2));
-        if(doubleCompare(dst, params.LENGTH1) == GT) return true;
-    }
-    return false;
- }
+bool lic7(Parameters_t params) {
+    return evaluateLic(7, params);
+}
 
 /* LIC 8
  *
@@ -287,53 +282,7 @@ bool isDistFromLine(Parameters_t params) {
  * within a circle of RADIUS1.
  */
 bool sepPointsContainedInCircle(Parameters_t params) {
-    // Base Cases (implicitly returns false if NUMPOINTS < 5)
-    if (params.A_PTS < 1 || params.B_PTS < 1 || params.A_PTS + params.B_PTS > params.NUMPOINTS - 3) return false;
-    
-    for (int i = 0; i < params.NUMPOINTS - params.A_PTS - params.B_PTS - 2; i++) {
-        double ax = params.X[i];
-        double bx = params.X[i+params.A_PTS+1];
-        double cx = params.X[i+params.A_PTS+params.B_PTS+2];
-        double ay = params.Y[i];
-        double by = params.Y[i+params.A_PTS+1];
-        double cy = params.Y[i+params.A_PTS+params.B_PTS+2];
-
-        // Make a triangle
-        double ab = hypot(bx - ax, by - ay);
-        double ac = hypot(cx - ax, cy - ay);
-        double bc = hypot(cx - bx, cy - by);
-        // If distance between two points is longer than diameter, cannot be kept within circle of radius RADIUS1
-        if(ab > params.RADIUS1 * 2 || ac > params.RADIUS1 * 2 || bc > params.RADIUS1 * 2) return true;
-        
-        // Check if distance between midpoints of longest side and the remaining point is within RADIUS1  
-        double dist;
-        if(ab > ac && ab > bc) {
-            double nx = (ax + bx) / 2;
-            double ny = (ay + by) / 2;
-            dist = hypot(cx - nx, cy - ny);
-        } else if (ac > ab && ac > bc) {
-            double nx = (ax + cx) / 2;
-            double ny = (ay + cy) / 2;
-            dist = hypot(bx - nx, by - ny);
-        } else {
-            double nx = (bx + cx) / 2;
-            double ny = (by + cy) / 2;
-            dist = hypot(ax - nx, ay - ny);
-        }
-        if (doubleCompare(dist, params.RADIUS1) != GT) continue;
-
-        // Calculate Circumradius 
-        // https://artofproblemsolving.com/wiki/index.php/Circumradius
-        // https://www.cuemath.com/geometry/area-of-triangle-in-coordinate-geometry/
-        double area = fabs(ax * (by-cy) + bx * (cy-ay) + cx * (ay-by)) / 2;
-        if (doubleCompare(area, 0) == EQ) continue;
-        double circumradius = (ab * bc * ac) / (4 * area);
-
-        if (doubleCompare(circumradius, params.RADIUS1) == GT) return true;
-    }
-
-    // If nothing was found
-    return false;
+    return evaluateLic(8, params);
 }
 
 /**  LIC 9
@@ -355,39 +304,7 @@ bool sepPointsContainedInCircle(Parameters_t params) {
  * @return boolean: Returns true if any angle is within the threshold, otherwise returns false.
  */
 bool isAngleWithinThreshold(Parameters_t params) {
-    // Base Cases (implicitly returns false if NUMPOINTS < 5)
-    if (params.C_PTS < 1 || params.D_PTS < 1 || params.C_PTS + params.D_PTS > params.NUMPOINTS - 3) return false;
-    if (params.EPSILON > PI || params.EPSILON < 0) return false;
-
-    for(int i = 0; i < params.NUMPOINTS - params.C_PTS - params.D_PTS - 2; i++){
-        int A = i;
-        int B = i + params.C_PTS + 1;
-        int C = i + params.C_PTS + params.D_PTS + 2;
-
-        //continue if point A or C are EQ to point B (vertex)
-        if(doubleCompare(params.X[A], params.X[B]) == EQ && doubleCompare(params.Y[A], params.Y[B]) == EQ) continue;
-        if(doubleCompare(params.X[B], params.X[C]) == EQ && doubleCompare(params.Y[B], params.Y[C]) == EQ) continue;
-
-        //calculate vector 2(B)->1(A) and 2(B)->3(C), vector B->A => A_i-B_i
-        double vectBAx = params.X[A] - params.X[B];
-        double vectBAy = params.Y[A] - params.Y[B];
-        double vectBCx = params.X[C] - params.X[B];
-        double vectBCy = params.Y[C] - params.Y[B];
-
-        //https://en.wikipedia.org/wiki/Dot_product
-        //angle = arctan (dot product / ||v1|| * ||v2||)
-        double dotproduct = vectBAx * vectBCx + vectBAy * vectBCy;
-        double vectBAmagnitude = sqrt(pow(vectBAx, 2) + pow(vectBAy, 2));
-        double vectBCmagnitude = sqrt(pow(vectBCx, 2) + pow(vectBCy, 2));
-        double angle = acos(dotproduct/vectBAmagnitude * vectBCmagnitude); //angle in rads
-
-        if(doubleCompare(angle, PI - params.EPSILON) == LT) return true;
-        if(doubleCompare(angle, PI + params.EPSILON) == GT) return true; // not really necessary as the angle calculated will be shortest distance between the vectors.
-    }
-
-    // If nothing was found
-    return false;
-
+    return evaluateLic(9, params);
 }
 
 // LIC 10
@@ -396,21 +313,8 @@ bool isAngleWithinThreshold(Parameters_t params) {
  * It iterates throgh the datapoints and if the area with the three specified points are larger then AREA1, the function returns true.
  * Otherwise it returns false.
  */
-bool lic10(Parameters_t params){
-     if(params.NUMPOINTS < 5 || params.E_PTS < 1 || params.F_PTS < 1 || params.AREA1 <= 0
-        || params.E_PTS + params.F_PTS > params.NUMPOINTS - 3) return false;
-
-     for(int i = 0; i < params.NUMPOINTS - params.E_PTS - params.F_PTS - 2; i++){
-          int second = i + params.E_PTS + 1;
-          int third = second + params.F_PTS + 1;
-    // determinant formula: https://www.cuemath.com/geometry/area-of-triangle-in-determinant-form/
-          double area = 0.5 * std::abs(
-            params.X[i]*(params.Y[second] - params.Y[third]) + 
-            params.X[second]*(params.Y[third]-params.Y[i]) + 
-            params.X[third]*(params.Y[i]) - params.Y[second]);
-            if(doubleCompare(area, params.AREA1) == GT) return true;
-     }
-     return false;
+bool lic10(Parameters_t params) {
+    return evaluateLic(10, params);
 }
 
 // LIC 11
@@ -422,12 +326,7 @@ bool lic10(Parameters_t params){
  * It returns false if no such comparison is found.
  */
 bool lic11(Parameters_t params) {
-    if(params.NUMPOINTS < 3 || params.G_PTS < 1 || params.G_PTS > params.NUMPOINTS - 2) return false;
-
-    for(int i = 0; i < params.NUMPOINTS - params.G_PTS - 1; i++){  
-        if(params.X[i + params.G_PTS + 1] - params.X[i] < 0) return true;
-    }
-    return false;
+    return evaluateLic(11, params);
 }
 
 /**  LIC 12
@@ -447,29 +346,9 @@ bool lic11(Parameters_t params) {
  *
  * @return boolean: true if both criteria stated above are filled, otherwise false. 
  */
- bool lic12(Parameters_t params) {
-
-    // Base Cases
-    if(params.NUMPOINTS < 3 || params.K_PTS < 1 || params.LENGTH1 < 0 || params.LENGTH2 < 0) return false;
-
-    bool gtL1 = false;
-    bool gtL2 = false;
-
-    for (int i = 0; i < params.NUMPOINTS - params.K_PTS - 1; i++) {
-        double length = hypot(params.X[i + params.K_PTS + 1] - params.X[i], params.Y[i + params.K_PTS + 1] - params.Y[i]);
-        if (doubleCompare(length, params.LENGTH1) == GT) {
-            gtL1 = true;
-            if (gtL2) return true;
-        }
-
-        if (doubleCompare(length, params.LENGTH2) == LT) {
-            gtL2 = true;
-            if (gtL1) return true;
-        }
-    }
-
-    return false;
- }
+bool lic12(Parameters_t params) {
+    return evaluateLic(12, params);
+}
 
 /**  LIC 13
  * 
@@ -494,38 +373,7 @@ bool lic11(Parameters_t params) {
  */
 
 bool lic13(Parameters_t params) {
-    // Base Cases (implicitly returns false if NUMPOINTS < 5)
-    if (params.A_PTS < 1 || params.B_PTS < 1 || params.A_PTS + params.B_PTS > params.NUMPOINTS - 3) return false;
-
-    bool radius1Condition = false;
-    bool radius2Condition = false;
-    
-    for (int i = 0; i < params.NUMPOINTS - params.A_PTS - params.B_PTS - 2; i++) {
-        double ax = params.X[i];
-        double bx = params.X[i+params.A_PTS+1];
-        double cx = params.X[i+params.A_PTS+params.B_PTS+2];
-        double ay = params.Y[i];
-        double by = params.Y[i+params.A_PTS+1];
-        double cy = params.Y[i+params.A_PTS+params.B_PTS+2];
-
-        // Make a triangle
-        double ab = hypot(bx - ax, by - ay);
-        double ac = hypot(cx - ax, cy - ay);
-        double bc = hypot(cx - bx, cy - by);
-        
-        // Calculate Circumradius 
-        // https://artofproblemsolving.com/wiki/index.php/Circumradius
-        // https://www.cuemath.com/geometry/area-of-triangle-in-coordinate-geometry/
-        double area = fabs(ax * (by-cy) + bx * (cy-ay) + cx * (ay-by)) / 2;
-        if (doubleCompare(area, 0) == EQ) continue;
-        double circumradius = (ab * bc * ac) / (4 * area);
-
-        if (doubleCompare(circumradius, params.RADIUS1) == GT) radius1Condition = true; //Assuming they fit if EQ to radius
-        if (doubleCompare(circumradius, params.RADIUS2) != GT) radius2Condition = true; //Assuming they fit if EQ to radius
-    }
-
-    if (radius1Condition && radius2Condition) return true;
-    return false;
+    return evaluateLic(13, params);
 }
 
 // LIC 14
@@ -536,24 +384,8 @@ bool lic13(Parameters_t params) {
  * After iterating through all points, if criteria for both AREA1 and AREA2 is fulfilled, the function returns true.
  * Otherwise it returns false.
  */
-bool lic14(Parameters_t params){
-     if(params.NUMPOINTS < 5 || params.AREA1 <= 0 || params.AREA2 <= 0) return false;
-
-     bool a1 = false;
-     bool a2 = false;
-     for(int i = 0; i < params.NUMPOINTS - params.E_PTS - params.F_PTS - 2; i++){
-          int second = i + params.E_PTS + 1;
-          int third = second + params.F_PTS + 1;
-          // determinant formula: https://www.cuemath.com/geometry/area-of-triangle-in-determinant-form/
-          double area = 0.5 * std::abs(
-            params.X[i]*(params.Y[second] - params.Y[third]) + 
-            params.X[second]*(params.Y[third]-params.Y[i]) + 
-            params.X[third]*(params.Y[i]) - params.Y[second]);
-          if(doubleCompare(area, params.AREA1) == GT) a1 = true;
-          if(doubleCompare(area, params.AREA2) == LT) a2 = true;
-     }
-     if(a1 && a2) return true;
-     return false;
+bool lic14(Parameters_t params) {
+    return evaluateLic(14, params);
 }
 /** generatePreliminaryUnlockingMatrix
  * This code generates the PUV matrix of bools, which is based on the LCM and the CMV. Depending on which
@@ -569,7 +401,7 @@ bool lic14(Parameters_t params){
  * @return boolean matrix: 15x15 symmetrical matrix where each point is true or false depending
  *         on the combination of the CMV and the LCM. Diagonal is always true.
  */
-std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::array<bool, 15> CMV, std::array<std::array<Connectors, 15>, 15> LCM) {
+std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::array<bool, 15> CMV, const std::array<std::array<Connectors, 15>, 15> &LCM) {
     std::array<std::array<bool, 15>, 15> retMatrix;
     for (int y = 0; y < 15; y++) {
         for (int x = 0; x < 15; x++) {
@@ -610,7 +442,7 @@ std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::arr
  * 
  * @return Final Unlocking Vector, 15 index vector of bools that will ultimately decide launch/no launch
 */
-std::array<bool, 15> generateFinalUnlockingVector(std::array<std::array<bool, 15>, 15> PUM, std::array<bool, 15> PUV) {
+std::array<bool, 15> generateFinalUnlockingVector(const std::array<std::array<bool, 15>, 15> &PUM, std::array<bool, 15> PUV) {
     std::array<bool, 15> FUV; 
     for (int i = 0; i < 15; i++) {
         if (PUV[i] == false) {
@@ -0,0 +1,159 @@
+#include "../include/decide_c.h"
+#include "../include/context.hpp"
+#include <algorithm>
+#include <new>
+
+struct decide_plan {
+    DecidePlan plan;
+};
+
+struct decide_session {
+    const decide_plan *plan;
+    DecideContext context;      // Scratch space, grows to the largest point set decided so far
+};
+
+static bool validPoints(const double *x, const double *y, int32_t numpoints) {
+    return numpoints >= 0 && (numpoints == 0 || (x != nullptr && y != nullptr));
+}
+
+static void runDecision(decide_session *session, const double *x, const double *y, int32_t numpoints, decide_result *result) {
+    DecideContext &context = session->context;
+    context.decide(session->plan->plan, x, y, numpoints);
+    result->cmv = cmvToMask(context.CMV());
+    result->fuv = cmvToMask(context.FUV());
+    result->launch = context.launch();
+    result->reserved[0] = result->reserved[1] = result->reserved[2] = 0;
+}
+
+// Grow the scratch space of a session, false if the allocation failed
+static bool reserveSession(decide_session *session, int32_t numpoints) {
+    try {
+        session->context.reserve(numpoints);
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+    return true;
+}
+
+int decide_abi_version(void) {
+    return DECIDE_ABI_VERSION;
+}
+
+/** decide_plan_create
+ * Validates a mission configuration and resolves its LIC kernels and used connectors.
+ *
+ * @param params Thresholds and separations
+ * @param lcm 225 connectors, DECIDE_NOTUSED, DECIDE_ORR or DECIDE_ANDD, must be symmetric
+ * @param puv PUV as a bitmask
+ * @param plan Output, the new plan
+ *
+ * @return DECIDE_SUCCESS, DECIDE_EINVAL for a null pointer or invalid LCM, DECIDE_ENOMEM
+ */
+int decide_plan_create(const decide_params *params, const uint8_t lcm[225], uint16_t puv, decide_plan **plan) {
+    if (params == nullptr || lcm == nullptr || plan == nullptr) return DECIDE_EINVAL;
+
+    static const Connectors connectors[3] = {NOTUSED, ORR, ANDD};
+    std::array<std::array<Connectors, 15>, 15> LCM;
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            uint8_t op = lcm[i * 15 + j];
+            if (op > DECIDE_ANDD || op != lcm[j * 15 + i]) return DECIDE_EINVAL;
+            LCM[i][j] = connectors[op];
+        }
+    }
+
+    Parameters_t p;
+    p.NUMPOINTS = 0;
+    p.X = nullptr;
+    p.Y = nullptr;
+    p.LENGTH1 = params->LENGTH1;
+    p.RADIUS1 = params->RADIUS1;
+    p.EPSILON = params->EPSILON;
+    p.AREA1 = params->AREA1;
+    p.DIST = params->DIST;
+    p.LENGTH2 = params->LENGTH2;
+    p.RADIUS2 = params->RADIUS2;
+    p.AREA2 = params->AREA2;
+    p.Q_PTS = params->Q_PTS;
+    p.QUADS = params->QUADS;
+    p.N_PTS = params->N_PTS;
+    p.K_PTS = params->K_PTS;
+    p.A_PTS = params->A_PTS;
+    p.B_PTS = params->B_PTS;
+    p.C_PTS = params->C_PTS;
+    p.D_PTS = params->D_PTS;
+    p.E_PTS = params->E_PTS;
+    p.F_PTS = params->F_PTS;
+    p.G_PTS = params->G_PTS;
+
+    decide_plan *created = new (std::nothrow) decide_plan;
+    if (created == nullptr) return DECIDE_ENOMEM;
+    std::array<bool, 15> PUV;
+    for (int i = 0; i < 15; i++) {
+        PUV[i] = puv >> i & 1;
+    }
+    created->plan = makeDecidePlan(p, LCM, PUV);
+    *plan = created;
+    return DECIDE_SUCCESS;
+}
+
+void decide_plan_destroy(decide_plan *plan) {
+    delete plan;
+}
+
+int decide_session_create(const decide_plan *plan, decide_session **session) {
+    if (plan == nullptr || session == nullptr) return DECIDE_EINVAL;
+    decide_session *created = new (std::nothrow) decide_session;
+    if (created == nullptr) return DECIDE_ENOMEM;
+    created->plan = plan;
+    *session = created;
+    return DECIDE_SUCCESS;
+}
+
+void decide_session_destroy(decide_session *session) {
+    delete session;
+}
+
+/** decide_run
+ * Decides one point set with the plan of a session.
+ *
+ * @param session Session from decide_session_create
+ * @param x X coordinates, may be null if numpoints is 0
+ * @param y Y coordinates, may be null if numpoints is 0
+ * @param numpoints Number of points
+ * @param result Output, caller owned
+ *
+ * @return DECIDE_SUCCESS, DECIDE_EINVAL, or DECIDE_ENOMEM if the session could not grow its scratch space
+ */
+int decide_run(decide_session *session, const double *x, const double *y, int32_t numpoints, decide_result *result) {
+    if (session == nullptr || result == nullptr || !validPoints(x, y, numpoints)) return DECIDE_EINVAL;
+    if (!reserveSession(session, numpoints)) return DECIDE_ENOMEM;
+    runDecision(session, x, y, numpoints, result);
+    return DECIDE_SUCCESS;
+}
+
+/** decide_run_batch
+ * Decides count point sets with the plan of a session. All items are checked before any is
+ * decided, and the scratch space is grown for the largest item up front, so on an error results is
+ * left untouched.
+ *
+ * @param session Session from decide_session_create
+ * @param items Point sets
+ * @param count Number of point sets
+ * @param results Output, count entries, caller owned
+ *
+ * @return DECIDE_SUCCESS, DECIDE_EINVAL, or DECIDE_ENOMEM if the session could not grow its scratch space
+ */
+int decide_run_batch(decide_session *session, const decide_points *items, int32_t count, decide_result *results) {
+    if (session == nullptr || count < 0 || (count > 0 && (items == nullptr || results == nullptr))) return DECIDE_EINVAL;
+    int32_t largest = 0;
+    for (int32_t k = 0; k < count; k++) {
+        if (!validPoints(items[k].x, items[k].y, items[k].numpoints)) return DECIDE_EINVAL;
+        largest = std::max(largest, items[k].numpoints);
+    }
+    if (!reserveSession(session, largest)) return DECIDE_ENOMEM;
+    for (int32_t k = 0; k < count; k++) {
+        runDecision(session, items[k].x, items[k].y, items[k].numpoints, &results[k]);
+    }
+    return DECIDE_SUCCESS;
+}
@@ -0,0 +1,249 @@
+#include "../include/dispatch.hpp"
+#include "../include/boxes.hpp"
+#include "../include/lic_windows.hpp"
+#include "../include/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// First line of a saved calibration profile
+static const char PROFILE_HEADER[] = "decide-dispatch 1";
+
+static const char *implementationNames[LIC_IMPLEMENTATIONS] = {"scalar", "kernel", "pruned", "threaded"};
+
+int dispatchSizeClass(int numPoints) {
+    int sizeClass = 0;
+    for (long long size = 8; size < numPoints && sizeClass < DISPATCH_SIZES - 1; size *= 4) sizeClass++;
+    return sizeClass;
+}
+
+static int dispatchSpanClass(int lic, const Parameters_t &params) {
+    return licWindowSpan(lic, params) < DISPATCH_WIDE_SPAN ? 0 : 1;
+}
+
+static bool prunable(int lic) {
+    return lic == 0 || lic == 1 || lic == 7 || lic == 12;
+}
+
+/** threadedLic
+ * Evaluates a LIC with its windows split into tasks of SCHEDULER_CHUNK windows on a pool. Flags are
+ * OR-ed into one shared word, and tasks starting after the required flags are raised skip their
+ * windows.
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the points
+ * @param pool WorkStealingPool running the tasks
+ *
+ * @return boolean: the LIC result
+ */
+static bool threadedLic(int lic, const Parameters_t &params, WorkStealingPool &pool) {
+    int count = licWindowCount(lic, params);
+    if (count <= 0) return false;
+    const unsigned required = licRequiredFlags(lic);
+    std::atomic<unsigned> flags{0};
+    auto scanChunk = [&](int chunk) {
+        if (flags.load(std::memory_order_relaxed) == required) return;
+        int first = chunk * SCHEDULER_CHUNK;
+        int last = std::min(first + SCHEDULER_CHUNK, count);
+        flags.fetch_or(licScan(lic, params, first, last), std::memory_order_relaxed);
+    };
+    pool.parallelFor((count + SCHEDULER_CHUNK - 1) / SCHEDULER_CHUNK, scanChunk);
+    return flags.load() == required;
+}
+
+bool evaluateLicWith(LicImplementation implementation, int lic, const Parameters_t &params, WorkStealingPool *pool) {
+    switch (implementation) {
+    case LIC_SCALAR:
+        return evaluateLic(lic, params);
+    case LIC_PRUNED:
+        if (prunable(lic)) return prunedLic(lic, params, BoxIndex(params));
+        break;
+    case LIC_THREADED:
+        if (pool != nullptr) return threadedLic(lic, params, *pool);
+        break;
+    default:
+        break;
+    }
+    return selectLicKernel(lic, params)(params);
+}
+
+LicDispatcher::LicDispatcher(WorkStealingPool *pool) : pool(pool) {
+    for (int lic = 0; lic < 15; lic++) {
+        for (int size = 0; size < DISPATCH_SIZES; size++) {
+            for (int span = 0; span < DISPATCH_SPANS; span++) table[lic][size][span] = LIC_KERNEL;
+        }
+    }
+}
+
+/*
+ * Points of a calibration run, moving right along a noisy line so that X never decreases. Steps
+ * of 1/32 keep the squared distances of the LIC 9 windows below 1, where lic9Flags gets a valid
+ * cosine and the straight line is inside [PI - EPSILON, PI + EPSILON].
+ */
+void calibrationPoints(double *X, double *Y, int numPoints) {
+    unsigned state = 2480;
+    for (int i = 0; i < numPoints; i++) {
+        state = state * 1103515245 + 12345;
+        X[i] = i / 32.0;
+        Y[i] = (state >> 8) / double(1 << 29);
+    }
+}
+
+/*
+ * Parameters of a calibration run: on calibrationPoints no LIC can trigger, so every implementation scans all its
+ * windows, and every separation is 1 or DISPATCH_WIDE_SPAN for the two span classes. AREA2 is the
+ * smallest positive double rather than 0, which licWindowCount rejects for LIC 14.
+ */
+Parameters_t calibrationParameters(int spanClass, double *X, double *Y, int numPoints) {
+    int separation = spanClass == 0 ? 1 : DISPATCH_WIDE_SPAN;
+    Parameters_t params = {};
+    params.NUMPOINTS = numPoints;
+    params.X = X;
+    params.Y = Y;
+    params.LENGTH1 = params.RADIUS1 = params.AREA1 = params.DIST = 1e300;
+    params.LENGTH2 = params.RADIUS2 = 0;
+    params.AREA2 = DBL_MIN;
+    params.EPSILON = PI;
+    params.QUADS = 3;
+    params.Q_PTS = params.N_PTS = separation + 2;
+    params.K_PTS = params.A_PTS = params.B_PTS = params.C_PTS = params.D_PTS = separation;
+    params.E_PTS = params.F_PTS = params.G_PTS = separation;
+    return params;
+}
+
+/** LicDispatcher::calibrate
+ * Times every implementation of every LIC for each point count class up to maxPoints and each span
+ * class, and keeps the fastest. On calibrationPoints no LIC of calibrationParameters triggers, so
+ * every implementation scans all its windows. Classes above maxPoints take the choices of the
+ * largest one timed.
+ *
+ * @param maxPoints Largest point set timed
+ * @param repetitions Timings of each implementation, the shortest counts
+ */
+void LicDispatcher::calibrate(int maxPoints, int repetitions) {
+    typedef std::chrono::steady_clock Clock;
+    int sizes = std::min(dispatchSizeClass(maxPoints) + 1, DISPATCH_SIZES);
+    int largest = 8 << (2 * (sizes - 1));
+    std::vector<double> X(largest), Y(largest);
+    calibrationPoints(X.data(), Y.data(), largest);
+
+    for (int size = 0; size < sizes; size++) {
+        int numPoints = std::min(8 << (2 * size), largest);
+        for (int span = 0; span < DISPATCH_SPANS; span++) {
+            Parameters_t params = calibrationParameters(span, X.data(), Y.data(), numPoints);
+            for (int lic = 0; lic < 15; lic++) {
+                double fastest = INFINITY;
+                for (int implementation = 0; implementation < LIC_IMPLEMENTATIONS; implementation++) {
+                    if (implementation == LIC_PRUNED && !prunable(lic)) continue;
+                    if (implementation == LIC_THREADED && pool == nullptr) continue;
+                    double shortest = INFINITY;
+                    for (int repetition = 0; repetition < repetitions; repetition++) {
+                        Clock::time_point start = Clock::now();
+                        evaluateLicWith((LicImplementation)implementation, lic, params, pool);
+                        shortest = std::min(shortest, std::chrono::duration<double>(Clock::now() - start).count());
+                    }
+                    if (shortest < fastest) {
+                        fastest = shortest;
+                        table[lic][size][span] = (LicImplementation)implementation;
+                    }
+                }
+            }
+        }
+    }
+    for (int size = sizes; size < DISPATCH_SIZES; size++) {
+        for (int lic = 0; lic < 15; lic++) {
+            for (int span = 0; span < DISPATCH_SPANS; span++) table[lic][size][span] = table[lic][sizes - 1][span];
+        }
+    }
+}
+
+/** LicDispatcher::load
+ * Reads a profile written by save. The whole table is replaced only if every entry reads back.
+ *
+ * @param path Profile file
+ *
+ * @return boolean: false if the file cannot be read or is not a complete profile
+ */
+bool LicDispatcher::load(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) return false;
+    char header[64] = {};
+    bool valid = fgets(header, sizeof(header), file) != nullptr &&
+                 strncmp(header, PROFILE_HEADER, strlen(PROFILE_HEADER)) == 0;
+
+    LicImplementation loaded[15][DISPATCH_SIZES][DISPATCH_SPANS];
+    for (int lic = 0; lic < 15 && valid; lic++) {
+        for (int size = 0; size < DISPATCH_SIZES && valid; size++) {
+            for (int span = 0; span < DISPATCH_SPANS && valid; span++) {
+                int readLic, readSize, readSpan;
+                char name[16];
+                valid = fscanf(file, "%d %d %d %15s", &readLic, &readSize, &readSpan, name) == 4 &&
+                        readLic == lic && readSize == size && readSpan == span;
+                int implementation = 0;
+                while (valid && implementation < LIC_IMPLEMENTATIONS && strcmp(name, implementationNames[implementation]) != 0) {
+                    implementation++;
+                }
+                valid = valid && implementation < LIC_IMPLEMENTATIONS;
+                if (valid) loaded[lic][size][span] = (LicImplementation)implementation;
+            }
+        }
+    }
+    fclose(file);
+    if (valid) std::memcpy(table, loaded, sizeof(table));
+    return valid;
+}
+
+bool LicDispatcher::save(const char *path) const {
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) return false;
+    fprintf(file, "%s\n", PROFILE_HEADER);
+    for (int lic = 0; lic < 15; lic++) {
+        for (int size = 0; size < DISPATCH_SIZES; size++) {
+            for (int span = 0; span < DISPATCH_SPANS; span++) {
+                fprintf(file, "%d %d %d %s\n", lic, size, span, implementationNames[table[lic][size][span]]);
+            }
+        }
+    }
+    return fclose(file) == 0;
+}
+
+LicImplementation LicDispatcher::choice(int lic, const Parameters_t &params) const {
+    return table[lic][dispatchSizeClass(params.NUMPOINTS)][dispatchSpanClass(lic, params)];
+}
+
+void LicDispatcher::setChoice(int lic, int sizeClass, int spanClass, LicImplementation implementation) {
+    table[lic][sizeClass][spanClass] = implementation;
+}
+
+bool LicDispatcher::evaluate(int lic, const Parameters_t &params) const {
+    return evaluateLicWith(choice(lic, params), lic, params, pool);
+}
+
+/** LicDispatcher::computeCMV
+ * Evaluates every LIC with its chosen implementation. The BoxIndex of the points is built once and
+ * shared by all the LICs that use LIC_PRUNED.
+ *
+ * @param params Parameters_t with the points
+ *
+ * @return CMV, the same as computeCMV(params)
+ */
+std::array<bool, 15> LicDispatcher::computeCMV(const Parameters_t &params) const {
+    std::array<bool, 15> CMV;
+    std::unique_ptr<BoxIndex> boxes;
+    for (int lic = 0; lic < 15; lic++) {
+        LicImplementation implementation = choice(lic, params);
+        if (implementation == LIC_PRUNED && prunable(lic)) {
+            if (!boxes) boxes.reset(new BoxIndex(params));
+            CMV[lic] = prunedLic(lic, params, *boxes);
+        } else {
+            CMV[lic] = evaluateLicWith(implementation, lic, params, pool);
+        }
+    }
+    return CMV;
+}
@@ -0,0 +1,166 @@
+#include "../include/exact.hpp"
+
+// Quantized thresholds are clamped here, above any squared quantity of in-range coordinates
+static const ExactInt EXACT_THRESHOLD_LIMIT = (ExactInt)1 << 126;
+
+// Largest integer <= value, -1 for a negative value so that any quantity compares greater
+static ExactInt quantizeFloor(long double value) {
+    if (value < 0) return -1;
+    if (value >= (long double)EXACT_THRESHOLD_LIMIT) return EXACT_THRESHOLD_LIMIT;
+    return (ExactInt)floorl(value);
+}
+
+// Smallest integer >= value, 0 for a value <= 0 so that no quantity compares smaller
+static ExactInt quantizeCeil(long double value) {
+    if (value <= 0) return 0;
+    if (value >= (long double)EXACT_THRESHOLD_LIMIT) return EXACT_THRESHOLD_LIMIT;
+    return (ExactInt)ceill(value);
+}
+
+// Squared length threshold: d > length iff d^2 > quantizeFloor(length^2), negative lengths always pass
+static ExactInt squaredLength(double length, double unitsPerLength) {
+    if (length < 0) return -1;
+    long double units = (long double)length * unitsPerLength;
+    return quantizeFloor(units * units);
+}
+
+/** makeExactPlan
+ * Quantizes the thresholds of params to the fixed-point coordinate units, once per mission. Each
+ * threshold is rounded in the direction that keeps a comparison with an integer quantity exact:
+ * "greater than" thresholds are floored and "less than" thresholds are ceiled.
+ *
+ * @param params Parameters_t with the thresholds and separations, the points are ignored
+ * @param unitsPerLength Coordinate units per unit of length of the thresholds
+ *
+ * @return plan for computeExactCMV
+ */
+ExactPlan makeExactPlan(const Parameters_t &params, double unitsPerLength) {
+    ExactPlan plan;
+    plan.params = params;
+    plan.params.NUMPOINTS = 0;
+    plan.params.X = nullptr;
+    plan.params.Y = nullptr;
+
+    long double areaUnits = (long double)unitsPerLength * unitsPerLength;
+    plan.length1Sq = squaredLength(params.LENGTH1, unitsPerLength);
+    plan.diameter1Sq = squaredLength(2 * params.RADIUS1, unitsPerLength);
+    plan.diameter2Sq = squaredLength(2 * params.RADIUS2, unitsPerLength);
+    plan.distSq = squaredLength(params.DIST, unitsPerLength);
+    plan.area1Twice = quantizeFloor(2 * params.AREA1 * areaUnits);
+    plan.area2Twice = quantizeCeil(2 * params.AREA2 * areaUnits);
+    if (params.LENGTH2 <= 0) {
+        plan.length2Sq = 0;
+    } else {
+        long double units = (long double)params.LENGTH2 * unitsPerLength;
+        plan.length2Sq = quantizeCeil(units * units);
+    }
+
+    // The deviation from a straight angle is in [0, PI]
+    plan.cosEpsilon = (int64_t)llroundl(cosl(params.EPSILON) * (1 << 30));
+    plan.sinEpsilon = (int64_t)llroundl(sinl(params.EPSILON) * (1 << 30));
+    if (params.EPSILON < 0) {
+        plan.angleMode = EXACT_ANGLE_ALWAYS;
+    } else if (params.EPSILON >= M_PI) {
+        plan.angleMode = EXACT_ANGLE_NEVER;
+    } else if (plan.sinEpsilon == 0) {
+        plan.angleMode = EXACT_ANGLE_BENT;
+    } else {
+        plan.angleMode = EXACT_ANGLE_DIRECTION;
+    }
+    return plan;
+}
+
+template <typename T>
+static bool coordinatesInRange(const T *X, const T *Y, int numPoints) {
+    for (int i = 0; i < numPoints; i++) {
+        if (X[i] < -EXACT_COORD_LIMIT || X[i] > EXACT_COORD_LIMIT) return false;
+        if (Y[i] < -EXACT_COORD_LIMIT || Y[i] > EXACT_COORD_LIMIT) return false;
+    }
+    return true;
+}
+
+bool exactCoordinatesInRange(const int32_t *X, const int32_t *Y, int numPoints) {
+    return coordinatesInRange(X, Y, numPoints);
+}
+
+bool exactCoordinatesInRange(const int64_t *X, const int64_t *Y, int numPoints) {
+    return coordinatesInRange(X, Y, numPoints);
+}
+
+// 256-bit product of two 128-bit values
+typedef struct {
+    ExactUInt high;
+    ExactUInt low;
+} WideProduct;
+
+static WideProduct multiplyWide(ExactUInt a, ExactUInt b) {
+    const ExactUInt mask = ~(uint64_t)0;
+    ExactUInt a0 = a & mask, a1 = a >> 64;
+    ExactUInt b0 = b & mask, b1 = b >> 64;
+    ExactUInt low = a0 * b0;
+    ExactUInt middle1 = a0 * b1;
+    ExactUInt middle2 = a1 * b0;
+
+    // Sum the middle terms in 64-bit halves to keep the carries
+    ExactUInt carry = (low >> 64) + (middle1 & mask) + (middle2 & mask);
+    WideProduct product;
+    product.low = (low & mask) | (carry << 64);
+    product.high = a1 * b1 + (middle1 >> 64) + (middle2 >> 64) + (carry >> 64);
+    return product;
+}
+
+/** exactProductGreater
+ * Compares two products of 128-bit values in 256 bits.
+ *
+ * @param a Non-negative factor
+ * @param b Non-negative factor
+ * @param c Factor of either sign, a negative c stands for a threshold every quantity passes
+ * @param d Non-negative factor
+ *
+ * @return boolean: true if a * b > c * d
+ */
+bool exactProductGreater(ExactUInt a, ExactUInt b, ExactInt c, ExactUInt d) {
+    if (c < 0) return d != 0 || (a != 0 && b != 0);
+    WideProduct left = multiplyWide(a, b);
+    WideProduct right = multiplyWide((ExactUInt)c, d);
+    return left.high != right.high ? left.high > right.high : left.low > right.low;
+}
+
+template <int LIC, typename Points>
+static bool exactLic(const ExactPlan &plan, const Points &pts, int count) {
+    const unsigned required = licRequiredFlags(LIC);
+    unsigned flags = 0;
+    for (int i = 0; i < count; i++) {
+        flags |= exactWindowFlags<LIC>(plan, pts, i);
+        if (flags == required) return true;
+    }
+    return false;
+}
+
+template <typename Points, int... LIC>
+static std::array<bool, 15> exactCMV(const ExactPlan &plan, const Points &pts, int numPoints, std::integer_sequence<int, LIC...>) {
+    Parameters_t counted = plan.params;
+    counted.NUMPOINTS = numPoints;
+    return {{ exactLic<LIC>(plan, pts, licWindowCount(LIC, counted))... }};
+}
+
+/** computeExactCMV
+ * Computes the CMV of fixed-point points with integer arithmetic only. The window counts and input
+ * checks are those of the double engine.
+ *
+ * @param plan ExactPlan from makeExactPlan
+ * @param X X coordinates, within EXACT_COORD_LIMIT
+ * @param Y Y coordinates, within EXACT_COORD_LIMIT
+ * @param numPoints Number of points
+ *
+ * @return CMV where index i is the result of LIC i
+ */
+std::array<bool, 15> computeExactCMV(const ExactPlan &plan, const int32_t *X, const int32_t *Y, int numPoints) {
+    IntegerPoints<int32_t> pts = {X, Y};
+    return exactCMV(plan, pts, numPoints, std::make_integer_sequence<int, 15>());
+}
+
+std::array<bool, 15> computeExactCMV(const ExactPlan &plan, const int64_t *X, const int64_t *Y, int numPoints) {
+    IntegerPoints<int64_t> pts = {X, Y};
+    return exactCMV(plan, pts, numPoints, std::make_integer_sequence<int, 15>());
+}
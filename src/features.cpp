@@ -0,0 +1,246 @@
+#include "../include/features.hpp"
+#include "../include/kernels.hpp"
+#include <cstdint>
+
+// Doubles per FEATURE_ALIGNMENT bytes
+static const int ALIGNED_DOUBLES = FEATURE_ALIGNMENT / sizeof(double);
+
+// Column length of maxPoints points rounded up so the next column stays aligned
+static size_t paddedColumn(int maxPoints) {
+    return (size_t)(maxPoints + ALIGNED_DOUBLES - 1) / ALIGNED_DOUBLES * ALIGNED_DOUBLES;
+}
+
+// True once the flags of windows [0, count) cover required, flagsOf(i) gives the flags of window i
+template <typename FlagsOf>
+static bool scanColumns(int count, unsigned required, FlagsOf flagsOf) {
+    unsigned flags = 0;
+    for (int i = 0; i < count; i++) {
+        flags |= flagsOf(i);
+        if (flags == required) return true;
+    }
+    return false;
+}
+
+FeatureColumns::FeatureColumns(int maxPoints) {
+    reserve(maxPoints);
+}
+
+/** FeatureColumns::reserve
+ * Grows the column storage to FEATURE_MAX_LAGS lags of maxPoints points and the per-point and
+ * per-window columns to maxPoints entries. Never shrinks.
+ *
+ * @param maxPoints Number of points the columns must cover
+ */
+void FeatureColumns::reserve(int maxPoints) {
+    if (maxPoints <= capacityPoints) return;
+    storage.resize(3 * FEATURE_MAX_LAGS * paddedColumn(maxPoints) + ALIGNED_DOUBLES);
+    quadrant.resize(maxPoints);
+    triangle.resize(maxPoints);
+    area.resize(maxPoints);
+    capacityPoints = maxPoints;
+}
+
+int FeatureColumns::capacity() const {
+    return capacityPoints;
+}
+
+const LagColumns *FeatureColumns::lag(int lag) const {
+    for (int i = 0; i < lagCount; i++) {
+        if (lags[i].lag == lag) return &lags[i];
+    }
+    return nullptr;
+}
+
+/** FeatureColumns::build
+ * Extracts the columns of a point set. Only the lags of LICs whose input checks pass are built,
+ * so every lag is in [1, NUMPOINTS - 1], and each lag is built once however many LICs share it.
+ *
+ * @param params Parameters_t with the points and separations
+ */
+void FeatureColumns::build(const Parameters_t &params) {
+    reserve(params.NUMPOINTS);
+    points = params.NUMPOINTS;
+    x = params.X;
+    y = params.Y;
+    ArrayPoints pts = {x, y};
+
+    int count[15];
+    for (int lic = 0; lic < 15; lic++) {
+        count[lic] = licWindowCount(lic, params);
+    }
+
+    int wanted[FEATURE_MAX_LAGS];
+    int wantedCount = 0;
+    auto want = [&](int lic, int lag) {
+        if (count[lic] <= 0) return;
+        for (int i = 0; i < wantedCount; i++) {
+            if (wanted[i] == lag) return;
+        }
+        wanted[wantedCount++] = lag;
+    };
+    want(0, 1);
+    want(1, 1);
+    want(2, 1);
+    want(7, params.K_PTS + 1);
+    want(12, params.K_PTS + 1);
+    want(8, params.A_PTS + 1);
+    want(8, params.B_PTS + 1);
+    want(8, params.A_PTS + params.B_PTS + 2);
+    want(13, params.A_PTS + 1);
+    want(13, params.B_PTS + 1);
+    want(13, params.A_PTS + params.B_PTS + 2);
+    want(9, params.C_PTS + 1);
+    want(9, params.D_PTS + 1);
+
+    // First storage index on a FEATURE_ALIGNMENT boundary
+    size_t base = 0;
+    while ((uintptr_t)(storage.data() + base) % FEATURE_ALIGNMENT != 0) base++;
+    size_t column = paddedColumn(points);
+
+    lagCount = wantedCount;
+    for (int l = 0; l < lagCount; l++) {
+        int lag = wanted[l];
+        double *dx = storage.data() + base + (3 * l) * column;
+        double *dy = dx + column;
+        double *normSq = dy + column;
+        for (int i = 0; i + lag < points; i++) {
+            dx[i] = x[i + lag] - x[i];
+            dy[i] = y[i + lag] - y[i];
+            normSq[i] = dx[i] * dx[i] + dy[i] * dy[i];
+        }
+        lags[l] = {lag, dx, dy, normSq};
+    }
+
+    if (count[4] > 0) {
+        for (int i = 0; i < points; i++) {
+            quadrant[i] = (uint8_t)pointQuadrant(x[i], y[i]);
+        }
+    }
+
+    int triangleWindows = std::max(count[8], count[13]);
+    if (triangleWindows > 0) {
+        const LagColumns *first = lag(params.A_PTS + 1);
+        const LagColumns *second = lag(params.B_PTS + 1);
+        const LagColumns *across = lag(params.A_PTS + params.B_PTS + 2);
+        for (int i = 0; i < triangleWindows; i++) {
+            int b = i + params.A_PTS + 1;
+            int c = b + params.B_PTS + 1;
+            WindowTriangle<> &t = triangle[i];
+            t.ab = std::hypot(first->dx[i], first->dy[i]);
+            t.ac = std::hypot(across->dx[i], across->dy[i]);
+            t.bc = std::hypot(second->dx[b], second->dy[b]);
+            t.circumradius = triangleCircumradius(x[i], y[i], x[b], y[b], x[c], y[c], t.ab, t.ac, t.bc);
+        }
+    }
+
+    int areaWindows = std::max(count[10], count[14]);
+    for (int i = 0; i < areaWindows; i++) {
+        area[i] = separatedTriangleArea(params, pts, i);
+    }
+}
+
+/** computeCMV
+ * Computes the CMV from the columns of a point set. LICs 0, 1, 7 and 12 read one lag column, LICs
+ * 2 and 9 take their vectors from the lag columns, LIC 4 reads the quadrant codes and LICs 8, 10,
+ * 13 and 14 read the per-window columns. LICs 5 and 11 run anyDescendingPair on the X coordinates.
+ * LICs 3 and 6 combine coordinates in ways no column holds (the determinant area, the distance to
+ * a line through varying points) and keep reading the coordinates, with the given kernels if any.
+ *
+ * @param features FeatureColumns built from params
+ * @param params Parameters_t with the thresholds and separations of the build
+ * @param kernels Kernel of each LIC, for example those of a DecidePlan, may be nullptr
+ *
+ * @return CMV where index i is the result of LIC i
+ */
+std::array<bool, 15> computeCMV(const FeatureColumns &features, const Parameters_t &params, const LicKernel *kernels) {
+    std::array<bool, 15> cmv{};
+    ArrayPoints pts = {features.X(), features.Y()};
+
+    for (int lic = 0; lic < 15; lic++) {
+        int count = licWindowCount(lic, params);
+        if (count <= 0) continue;
+        unsigned required = licRequiredFlags(lic);
+
+        switch (lic) {
+            case 0: case 1: {
+                const LagColumns *c = features.lag(1);
+                cmv[lic] = scanColumns(count, required, [&](int i) {
+                    double distance = std::sqrt(c->normSq[i]);
+                    return lic == 0 ? lic0Flags(params, distance) : lic1Flags(params, distance);
+                });
+                break;
+            }
+            case 2: {
+                // Vectors from the middle point: back along window i, forward along window i + 1
+                const LagColumns *c = features.lag(1);
+                cmv[lic] = scanColumns(count, required, [&](int i) {
+                    return lic2Flags(params, -c->dx[i], -c->dy[i], c->dx[i+1], c->dy[i+1],
+                                     std::sqrt(c->normSq[i]), std::sqrt(c->normSq[i+1]));
+                });
+                break;
+            }
+            case 4: {
+                const uint8_t *quadrants = features.quadrants();
+                cmv[lic] = scanColumns(count, required, [&](int j) {
+                    unsigned quads = 0;
+                    for (int i = j; i < j + params.Q_PTS; i++) {
+                        quads |= 1u << quadrants[i];
+                    }
+                    int quadCount = (quads & 1) + (quads >> 1 & 1) + (quads >> 2 & 1) + (quads >> 3 & 1);
+                    return (unsigned)(params.QUADS < quadCount);
+                });
+                break;
+            }
+            case 5: case 11:
+                // Compares X with itself shifted, no column needed
+                cmv[lic] = anyDescendingPair(features.X(), lic == 5 ? 1 : params.G_PTS + 1, count);
+                break;
+            case 7: case 12: {
+                const LagColumns *c = features.lag(params.K_PTS + 1);
+                cmv[lic] = scanColumns(count, required, [&](int i) {
+                    if (lic == 7) return lic7Flags(params, std::sqrt(c->normSq[i]));
+                    return lic12Flags(params, std::hypot(c->dx[i], c->dy[i]));
+                });
+                break;
+            }
+            case 8: {
+                const WindowTriangle<> *triangles = features.triangles();
+                cmv[lic] = scanColumns(count, required, [&](int i) { return lic8Flags(params, pts, i, triangles[i]); });
+                break;
+            }
+            case 9: {
+                // BA is the lag C_PTS + 1 delta at A reversed, BC the lag D_PTS + 1 delta at B
+                const LagColumns *ba = features.lag(params.C_PTS + 1);
+                const LagColumns *bc = features.lag(params.D_PTS + 1);
+                cmv[lic] = scanColumns(count, required, [&](int a) {
+                    int b = a + params.C_PTS + 1;
+                    if (doubleCompare(ba->dx[a], 0) == EQ && doubleCompare(ba->dy[a], 0) == EQ) return 0u;
+                    if (doubleCompare(bc->dx[b], 0) == EQ && doubleCompare(bc->dy[b], 0) == EQ) return 0u;
+                    return lic9Flags(params, -ba->dx[a], -ba->dy[a], bc->dx[b], bc->dy[b],
+                                     std::sqrt(ba->normSq[a]), std::sqrt(bc->normSq[b]));
+                });
+                break;
+            }
+            case 10: case 14: {
+                const double *areas = features.areas();
+                cmv[lic] = scanColumns(count, required, [&](int i) {
+                    return lic == 10 ? lic10Flags(params, areas[i]) : lic14Flags(params, areas[i]);
+                });
+                break;
+            }
+            case 13: {
+                const WindowTriangle<> *triangles = features.triangles();
+                cmv[lic] = scanColumns(count, required, [&](int i) { return lic13Flags(params, triangles[i]); });
+                break;
+            }
+            default:
+                if (kernels != nullptr) {
+                    cmv[lic] = kernels[lic](params);
+                } else {
+                    cmv[lic] = licScanPoints(lic, params, pts, 0, count) == required;
+                }
+                break;
+        }
+    }
+    return cmv;
+}
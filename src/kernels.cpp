@@ -0,0 +1,241 @@
+#include "../include/kernels.hpp"
+#include <utility>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Separations with specialised kernels: FIXED_VALUES values starting at the smallest valid one
+static const int FIXED_VALUES = 4;
+
+// Runtime dispatch of licScanBlocks over all windows of a LIC
+template <typename Points>
+static unsigned scanBlocks(int lic, const Parameters_t &params, const Points &pts, int count) {
+    switch (lic) {
+    case 0: return licScanBlocks<0>(params, pts, 0, count);
+    case 1: return licScanBlocks<1>(params, pts, 0, count);
+    case 2: return licScanBlocks<2>(params, pts, 0, count);
+    case 3: return licScanBlocks<3>(params, pts, 0, count);
+    case 4: return licScanBlocks<4>(params, pts, 0, count);
+    case 5: return licScanBlocks<5>(params, pts, 0, count);
+    case 6: return licScanBlocks<6>(params, pts, 0, count);
+    case 7: return licScanBlocks<7>(params, pts, 0, count);
+    case 8: return licScanBlocks<8>(params, pts, 0, count);
+    case 9: return licScanBlocks<9>(params, pts, 0, count);
+    case 10: return licScanBlocks<10>(params, pts, 0, count);
+    case 11: return licScanBlocks<11>(params, pts, 0, count);
+    case 12: return licScanBlocks<12>(params, pts, 0, count);
+    case 13: return licScanBlocks<13>(params, pts, 0, count);
+    case 14: return licScanBlocks<14>(params, pts, 0, count);
+    }
+    return 0;
+}
+
+// Pairs compared between two early exit checks of anyDescendingPair
+static const int DESCENDING_BLOCK = 8;
+
+/** anyDescendingPair
+ * Compares X against itself shifted by lag a block of DESCENDING_BLOCK pairs at a time: the vector
+ * compares of a block are ORed and reduced with one movemask, so the only branch is the exit check
+ * per block. Uses AVX or SSE2 when the compiler targets them, the tail and other targets compare
+ * one pair at a time. The compares are ordered, so a NaN never makes a pair descending, as in the
+ * scalar X[i] > X[i + lag]. For LIC 11 this is the same test as X[j] - X[i] < 0: the difference
+ * of two doubles is negative exactly when the first is smaller, and inf - inf is NaN.
+ *
+ * @param X X coordinates
+ * @param lag Distance between the compared points, at least 1
+ * @param count Number of pairs, X must hold count + lag values
+ *
+ * @return boolean: true if some pair is descending
+ */
+bool anyDescendingPair(const double *X, int lag, int count) {
+    int i = 0;
+#if defined(__AVX__)
+    for (; i + DESCENDING_BLOCK <= count; i += DESCENDING_BLOCK) {
+        __m256d low = _mm256_cmp_pd(_mm256_loadu_pd(X + i), _mm256_loadu_pd(X + i + lag), _CMP_GT_OQ);
+        __m256d high = _mm256_cmp_pd(_mm256_loadu_pd(X + i + 4), _mm256_loadu_pd(X + i + lag + 4), _CMP_GT_OQ);
+        if (_mm256_movemask_pd(_mm256_or_pd(low, high))) return true;
+    }
+#elif defined(__SSE2__)
+    for (; i + DESCENDING_BLOCK <= count; i += DESCENDING_BLOCK) {
+        __m128d gt = _mm_cmpgt_pd(_mm_loadu_pd(X + i), _mm_loadu_pd(X + i + lag));
+        gt = _mm_or_pd(gt, _mm_cmpgt_pd(_mm_loadu_pd(X + i + 2), _mm_loadu_pd(X + i + lag + 2)));
+        gt = _mm_or_pd(gt, _mm_cmpgt_pd(_mm_loadu_pd(X + i + 4), _mm_loadu_pd(X + i + lag + 4)));
+        gt = _mm_or_pd(gt, _mm_cmpgt_pd(_mm_loadu_pd(X + i + 6), _mm_loadu_pd(X + i + lag + 6)));
+        if (_mm_movemask_pd(gt)) return true;
+    }
+#endif
+    for (; i < count; i++) {
+        if (X[i] > X[i + lag]) return true;
+    }
+    return false;
+}
+
+// LIC 5 and 11 kernel, runs for any G_PTS
+template <int LIC>
+static bool descendingLic(const Parameters_t &params) {
+    int count = licWindowCount(LIC, params);
+    if (count <= 0) return false;
+    return anyDescendingPair(params.X, LIC == 5 ? 1 : params.G_PTS + 1, count);
+}
+
+template <int LIC>
+static bool runtimeLic(const Parameters_t &params) {
+    return evaluateLic(LIC, params);
+}
+
+template <int LIC, int FIRST, int... S>
+static constexpr std::array<LicKernel, sizeof...(S)> singleTable(std::integer_sequence<int, S...>) {
+    return {{ &fixedLic<LIC, FIRST + S, 0>... }};
+}
+
+template <int LIC, int... S>
+static constexpr std::array<LicKernel, sizeof...(S)> pairTable(std::integer_sequence<int, S...>) {
+    return {{ &fixedLic<LIC, 1 + S / FIXED_VALUES, 1 + S % FIXED_VALUES>... }};
+}
+
+template <int LIC, int FIRST>
+static LicKernel pickSingle(int s1) {
+    static constexpr auto table = singleTable<LIC, FIRST>(std::make_integer_sequence<int, FIXED_VALUES>());
+    if (s1 < FIRST || s1 >= FIRST + FIXED_VALUES) return &runtimeLic<LIC>;
+    return table[s1 - FIRST];
+}
+
+template <int LIC>
+static LicKernel pickPair(int s1, int s2) {
+    static constexpr auto table = pairTable<LIC>(std::make_integer_sequence<int, FIXED_VALUES * FIXED_VALUES>());
+    if (s1 < 1 || s1 > FIXED_VALUES || s2 < 1 || s2 > FIXED_VALUES) return &runtimeLic<LIC>;
+    return table[(s1 - 1) * FIXED_VALUES + (s2 - 1)];
+}
+
+/** selectLicKernel
+ * Picks the kernel for one LIC from the dispatch table. LICs with separations get a kernel with the
+ * separations as template parameters when they are among the FIXED_VALUES smallest valid values,
+ * the LICs without separations always get a blocked kernel. LICs 5 and 11 always get the vector
+ * kernel of anyDescendingPair. Anything else falls back to the runtime scan.
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the separations of the mission profile
+ *
+ * @return kernel for the LIC, only valid for params with the same separations
+ */
+LicKernel selectLicKernel(int lic, const Parameters_t &params) {
+    switch (lic) {
+    case 0: return &fixedLic<0, 0, 0>;
+    case 1: return &fixedLic<1, 0, 0>;
+    case 2: return &fixedLic<2, 0, 0>;
+    case 3: return &fixedLic<3, 0, 0>;
+    case 4: return pickSingle<4, 2>(params.Q_PTS);
+    case 5: return &descendingLic<5>;
+    case 6: return pickSingle<6, 3>(params.N_PTS);
+    case 7: return pickSingle<7, 1>(params.K_PTS);
+    case 8: return pickPair<8>(params.A_PTS, params.B_PTS);
+    case 9: return pickPair<9>(params.C_PTS, params.D_PTS);
+    case 10: return pickPair<10>(params.E_PTS, params.F_PTS);
+    case 11: return &descendingLic<11>;
+    case 12: return pickSingle<12, 1>(params.K_PTS);
+    case 13: return pickPair<13>(params.A_PTS, params.B_PTS);
+    case 14: return pickPair<14>(params.E_PTS, params.F_PTS);
+    }
+    return nullptr;
+}
+
+static const LicKernel RUNTIME_KERNELS[15] = {
+    &runtimeLic<0>, &runtimeLic<1>, &runtimeLic<2>, &runtimeLic<3>, &runtimeLic<4>,
+    &runtimeLic<5>, &runtimeLic<6>, &runtimeLic<7>, &runtimeLic<8>, &runtimeLic<9>,
+    &runtimeLic<10>, &runtimeLic<11>, &runtimeLic<12>, &runtimeLic<13>, &runtimeLic<14>
+};
+
+bool hasFixedLicKernel(int lic, const Parameters_t &params) {
+    return selectLicKernel(lic, params) != RUNTIME_KERNELS[lic];
+}
+
+/** makeDecidePlan
+ * Resolves the kernel of every LIC once, so repeated decisions with the same mission profile do not
+ * go through the dispatch again. The overload taking an LCM and PUV also stores the launch
+ * configuration, as a SparseLCM.
+ *
+ * @param params Parameters_t with the thresholds and separations, the points are ignored
+ *
+ * @return plan to pass to computeCMV
+ */
+DecidePlan makeDecidePlan(const Parameters_t &params) {
+    DecidePlan plan;
+    plan.params = params;
+    plan.params.NUMPOINTS = 0;
+    plan.params.X = nullptr;
+    plan.params.Y = nullptr;
+    for (int i = 0; i < 15; i++) {
+        plan.kernels[i] = selectLicKernel(i, params);
+    }
+    plan.LCM.count = 0;
+    plan.PUV.fill(false);
+    return plan;
+}
+
+DecidePlan makeDecidePlan(const Parameters_t &params, const std::array<std::array<Connectors, 15>, 15> &LCM, std::array<bool, 15> PUV) {
+    DecidePlan plan = makeDecidePlan(params);
+    plan.LCM = sparseLCM(packLCM(LCM));
+    plan.PUV = PUV;
+    return plan;
+}
+
+/** computeCMV
+ * Computes the CMV of a point set with the kernels resolved in a plan.
+ *
+ * @param plan DecidePlan from makeDecidePlan
+ * @param X X coordinates of the points
+ * @param Y Y coordinates of the points
+ * @param numPoints Number of points
+ *
+ * @return CMV where index i is the result of LIC i
+ */
+std::array<bool, 15> computeCMV(const DecidePlan &plan, const double *X, const double *Y, int numPoints) {
+    Parameters_t params = plan.params;
+    params.NUMPOINTS = numPoints;
+    params.X = const_cast<double *>(X);
+    params.Y = const_cast<double *>(Y);
+
+    std::array<bool, 15> CMV;
+    for (int i = 0; i < 15; i++) {
+        CMV[i] = plan.kernels[i](params);
+    }
+    return CMV;
+}
+
+/** computeCMV
+ * Computes the CMV of points stored as T. The window predicates compute in T and compare with
+ * scalarCompare, so float points run float arithmetic throughout with floatCompare tolerances,
+ * while T = double gives the same CMV as computeCMV(params).
+ *
+ * @param params Parameters_t with the thresholds and separations, its points are ignored
+ * @param X X coordinates of the points
+ * @param Y Y coordinates of the points
+ * @param numPoints Number of points
+ *
+ * @return CMV where index i is the result of LIC i
+ */
+template <typename T>
+std::array<bool, 15> computeCMV(const Parameters_t &params, const T *X, const T *Y, int numPoints) {
+    typedef typename std::conditional<std::is_same<T, float>::value, FloatPoints, ArrayPoints>::type Points;
+    Points pts = {X, Y};
+    Parameters_t counted = params;
+    counted.NUMPOINTS = numPoints;
+
+    std::array<bool, 15> CMV;
+    for (int i = 0; i < 15; i++) {
+        if constexpr (std::is_same<T, double>::value) {
+            if (i == 5 || i == 11) {
+                int count = licWindowCount(i, counted);
+                CMV[i] = count > 0 && anyDescendingPair(static_cast<const double *>(X), i == 5 ? 1 : counted.G_PTS + 1, count);
+                continue;
+            }
+        }
+        CMV[i] = scanBlocks(i, counted, pts, licWindowCount(i, counted)) == licRequiredFlags(i);
+    }
+    return CMV;
+}
+
+template std::array<bool, 15> computeCMV<float>(const Parameters_t &, const float *, const float *, int);
+template std::array<bool, 15> computeCMV<double>(const Parameters_t &, const double *, const double *, int);
@@ -0,0 +1,227 @@
+#include "../include/lcm.hpp"
+#include <algorithm>
+#include <utility>
+
+// 2 bit codes of the connectors in PackedLCM and LcmEntry
+static const Connectors CONNECTOR_CODES[4] = {NOTUSED, ORR, ANDD, NOTUSED};
+
+static uint64_t connectorCode(Connectors op) {
+    if (op == ORR) return 1;
+    if (op == ANDD) return 2;
+    return 0;
+}
+
+static unsigned pairCode(const PackedLCM &packed, int pair) {
+    return packed.words[pair / 32] >> (2 * (pair % 32)) & 3;
+}
+
+/** packLCM
+ * Packs a symmetric LCM into 2 bits per entry above the diagonal, 32 bytes in total. The lower
+ * triangle and the diagonal are not stored.
+ *
+ * @param LCM Logical Connector Matrix, assumed symmetric
+ *
+ * @return PackedLCM with the connectors LCM[i][j] for i < j
+ */
+PackedLCM packLCM(const std::array<std::array<Connectors, 15>, 15> &LCM) {
+    PackedLCM packed = {{0, 0, 0, 0}};
+    for (int i = 0; i < 15; i++) {
+        for (int j = i + 1; j < 15; j++) {
+            int pair = lcmPairIndex(i, j);
+            packed.words[pair / 32] |= connectorCode(LCM[i][j]) << (2 * (pair % 32));
+        }
+    }
+    return packed;
+}
+
+Connectors packedConnector(const PackedLCM &packed, int i, int j) {
+    if (i == j) return NOTUSED;
+    if (i > j) std::swap(i, j);
+    return CONNECTOR_CODES[pairCode(packed, lcmPairIndex(i, j))];
+}
+
+std::array<std::array<Connectors, 15>, 15> unpackLCM(const PackedLCM &packed) {
+    std::array<std::array<Connectors, 15>, 15> LCM;
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            LCM[i][j] = packedConnector(packed, i, j);
+        }
+    }
+    return LCM;
+}
+
+/** sparseLCM
+ * Lists the connectors of a packed LCM that are not NOTUSED. Whole words without a used connector
+ * are skipped.
+ *
+ * @param packed PackedLCM
+ *
+ * @return SparseLCM with one entry per used connector, ordered by row
+ */
+SparseLCM sparseLCM(const PackedLCM &packed) {
+    SparseLCM sparse;
+    sparse.count = 0;
+    int pair = 0;
+    for (int i = 0; i < 15; i++) {
+        for (int j = i + 1; j < 15; j++, pair++) {
+            if (packed.words[pair / 32] == 0) continue;
+            unsigned code = pairCode(packed, pair);
+            if (CONNECTOR_CODES[code] == NOTUSED) continue;
+            sparse.entries[sparse.count++] = {(uint8_t)i, (uint8_t)j, (uint8_t)code};
+        }
+    }
+    return sparse;
+}
+
+// True if the connector of an entry holds for the CMV
+static bool entryHolds(const LcmEntry &entry, const std::array<bool, 15> &CMV) {
+    if (entry.op == 2) return CMV[entry.i] && CMV[entry.j];
+    return CMV[entry.i] || CMV[entry.j];
+}
+
+/** generatePreliminaryUnlockingMatrix
+ * Same PUM as the dense version, but starts from an all true matrix (what NOTUSED and the
+ * diagonal give) and only visits the used connectors.
+ *
+ * @param CMV Conditions Met Vector
+ * @param LCM SparseLCM with the used connectors
+ *
+ * @return boolean matrix: 15x15 symmetrical PUM
+ */
+std::array<std::array<bool, 15>, 15> generatePreliminaryUnlockingMatrix(std::array<bool, 15> CMV, const SparseLCM &LCM) {
+    std::array<std::array<bool, 15>, 15> retMatrix;
+    for (int y = 0; y < 15; y++) {
+        retMatrix[y].fill(true);
+    }
+    for (int k = 0; k < LCM.count; k++) {
+        const LcmEntry &entry = LCM.entries[k];
+        bool holds = entryHolds(entry, CMV);
+        retMatrix[entry.i][entry.j] = holds;
+        retMatrix[entry.j][entry.i] = holds;
+    }
+    return retMatrix;
+}
+
+/** generateFinalUnlockingVector
+ * Computes the FUV without building the PUM: a row fails if any used connector in it does not hold,
+ * and a failing connector makes both of its rows fail since the LCM is symmetric.
+ *
+ * @param CMV Conditions Met Vector
+ * @param LCM SparseLCM with the used connectors
+ * @param PUV Preliminary Unlocking Vector
+ *
+ * @return Final Unlocking Vector, same as generateFinalUnlockingVector on the PUM
+ */
+std::array<bool, 15> generateFinalUnlockingVector(std::array<bool, 15> CMV, const SparseLCM &LCM, std::array<bool, 15> PUV) {
+    uint16_t failedRows = 0;
+    for (int k = 0; k < LCM.count; k++) {
+        const LcmEntry &entry = LCM.entries[k];
+        if (!entryHolds(entry, CMV)) failedRows |= (1u << entry.i) | (1u << entry.j);
+    }
+
+    std::array<bool, 15> FUV;
+    for (int i = 0; i < 15; i++) {
+        FUV[i] = !PUV[i] || !(failedRows >> i & 1);
+    }
+    return FUV;
+}
+
+/** settledLaunch
+ * Decides whether the launch decision is already fixed while some CMV entries are still being
+ * computed. Only the connectors in a row with PUV set matter. Launch is ruled out once one of them
+ * fails for the known entries alone (an ANDD with a known false side, an ORR with both sides known
+ * false), and certain once all of them hold for the known entries alone.
+ *
+ * @param known Bit i set if CMV entry i is known
+ * @param CMV Bit i is CMV entry i, ignored where not known
+ * @param LCM SparseLCM with the used connectors
+ * @param PUV Preliminary Unlocking Vector
+ *
+ * @return 1 or 0 if the launch decision is settled, -1 if it depends on unknown entries
+ */
+int settledLaunch(uint16_t known, uint16_t CMV, const SparseLCM &LCM, std::array<bool, 15> PUV) {
+    uint16_t knownTrue = known & CMV, knownFalse = known & ~CMV;
+    bool allHold = true;
+    for (int k = 0; k < LCM.count; k++) {
+        const LcmEntry &entry = LCM.entries[k];
+        if (!PUV[entry.i] && !PUV[entry.j]) continue;
+        uint16_t sides = (1u << entry.i) | (1u << entry.j);
+        bool fails = entry.op == 2 ? (knownFalse & sides) != 0 : (knownFalse & sides) == sides;
+        if (fails) return 0;
+        bool holds = entry.op == 2 ? (knownTrue & sides) == sides : (knownTrue & sides) != 0;
+        allHold = allHold && holds;
+    }
+    return allHold ? 1 : -1;
+}
+
+/** ConfigBatch::add
+ * Transposes a configuration into bit c % 64 of the slice words of slice c / 64.
+ *
+ * @param LCM PackedLCM of the configuration
+ * @param PUV Preliminary Unlocking Vector of the configuration
+ *
+ * @return index of the configuration
+ */
+int ConfigBatch::add(const PackedLCM &LCM, std::array<bool, 15> PUV) {
+    if (count % CONFIGS_PER_WORD == 0) {
+        slices.push_back(ConfigSlice());
+        ConfigSlice &slice = slices.back();
+        std::fill(slice.orr, slice.orr + LCM_PAIRS, 0);
+        std::fill(slice.andd, slice.andd + LCM_PAIRS, 0);
+        std::fill(slice.puv, slice.puv + 15, 0);
+    }
+    ConfigSlice &slice = slices.back();
+    uint64_t bit = 1ull << (count % CONFIGS_PER_WORD);
+    for (int pair = 0; pair < LCM_PAIRS; pair++) {
+        unsigned code = pairCode(LCM, pair);
+        if (code == 1) slice.orr[pair] |= bit;
+        if (code == 2) slice.andd[pair] |= bit;
+    }
+    for (int i = 0; i < 15; i++) {
+        if (PUV[i]) slice.puv[i] |= bit;
+    }
+    return count++;
+}
+
+int ConfigBatch::size() const {
+    return count;
+}
+
+/** ConfigBatch::launchDecisions
+ * Decides every configuration in the batch for one CMV. Since the CMV is the same for all of them,
+ * each pair only selects which connector kinds fail there (ORR fails if neither LIC is met, ANDD
+ * if either is not), and the failure words are ORed into the rows of both LICs. A configuration
+ * launches if no row selected by its PUV failed.
+ *
+ * @param cmv CMV bitmask, bit i set if LIC i is met
+ *
+ * @return launch bits, configuration c is bit c % 64 of word c / 64, unused bits are 0
+ */
+std::vector<uint64_t> ConfigBatch::launchDecisions(uint16_t cmv) const {
+    std::vector<uint64_t> launch(slices.size());
+    for (size_t s = 0; s < slices.size(); s++) {
+        const ConfigSlice &slice = slices[s];
+        uint64_t rowFailed[15] = {0};
+        int pair = 0;
+        for (int i = 0; i < 15; i++) {
+            uint64_t metI = cmv >> i & 1;
+            for (int j = i + 1; j < 15; j++, pair++) {
+                uint64_t metJ = cmv >> j & 1;
+                uint64_t orrFails = (metI | metJ) - 1;      // all ones if neither is met
+                uint64_t anddFails = (metI & metJ) - 1;     // all ones unless both are met
+                uint64_t failed = (slice.orr[pair] & orrFails) | (slice.andd[pair] & anddFails);
+                rowFailed[i] |= failed;
+                rowFailed[j] |= failed;
+            }
+        }
+
+        uint64_t decisions = ~0ull;
+        for (int i = 0; i < 15; i++) {
+            decisions &= ~(slice.puv[i] & rowFailed[i]);
+        }
+        int inSlice = std::min(CONFIGS_PER_WORD, count - (int)s * CONFIGS_PER_WORD);
+        if (inSlice < CONFIGS_PER_WORD) decisions &= (1ull << inSlice) - 1;
+        launch[s] = decisions;
+    }
+    return launch;
+}
@@ -1,8 +1,21 @@
 #include "../include/decide.hpp"
+#include "../include/server.hpp"
 #include <array>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
 int main(int argc, char** argv) {
+  // decide --serve /path/sock [workers]: answer requests on a Unix domain socket instead
+  if (argc >= 3 && strcmp(argv[1], "--serve") == 0) {
+    int workers = argc >= 4 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    if (runServer(argv[2], workers) != 0) {
+      std::cerr << "Could not listen on " << argv[2] << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
   //std::cout << "Starting program...\n"; // Debugging Step
   // Step 1: Initialize Parameters
   Parameters_t params;
@@ -23,27 +36,14 @@ int main(int argc, char** argv) {
   params.NUMPOINTS = 8; 
   params.AREA1 = 20;
   params.AREA2 = 12;
-  params.X = new double[8]{-100, 0, 2, 0, 1, 12, -50, 2};
-  params.Y = new double[8]{0, -1, 3, 100, 0, 32, 50, -2};
+  double X[8] = {-100, 0, 2, 0, 1, 12, -50, 2};
+  double Y[8] = {0, -1, 3, 100, 0, 32, 50, -2};
+  params.X = X;
+  params.Y = Y;
 
   //std::cout << "Parameters initialized.\n"; // Debugging Step
   // Step 2: Compute CMV
-  std::array<bool, 15> CMV = {false};
-  CMV[0] = isConsecDistGTLen(params);
-  CMV[1] = lic1(params);
-  CMV[2] = lic2(params);
-  CMV[3] = lic3(params);
-  CMV[4] = lic4(params);
-  CMV[5] = lic5(params);
-  CMV[6] = isDistFromLine(params);
-  CMV[7] = lic7(params);
-  CMV[8] = sepPointsContainedInCircle(params);  
-  CMV[9] = isAngleWithinThreshold(params);  
-  CMV[10] = lic10(params);
-  CMV[11] = lic11(params);
-  CMV[12] = lic12(params);
-  CMV[13] = lic13(params);
-  CMV[14] = lic14(params);
+  std::array<bool, 15> CMV = computeCMV(params);
 
   //std::cout << "CMV Computed\n"; // Debugging Step
   // Step 3: Initialize Logical Connector Matrix (LCM)
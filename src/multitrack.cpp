@@ -0,0 +1,363 @@
+#include "../include/multitrack.hpp"
+#include "../include/lic_windows.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Points of one lane in a TrackBlock
+struct LanePoints {
+    const double *X;
+    const double *Y;
+    double x(int i) const { return X[i * TRACK_LANES]; }
+    double y(int i) const { return Y[i * TRACK_LANES]; }
+};
+
+/** addTrack
+ * Copies a track into the last block with a free lane, or into a new block. If the track is longer
+ * than the tracks already in the block, the block grows to the new length and the other lanes are
+ * padded with zeros.
+ *
+ * @param X X coordinates of the track
+ * @param Y Y coordinates of the track
+ * @param numPoints Number of points in the track
+ *
+ * @return index of the track, which is also its index in the result of evaluate()
+ */
+int MultiTrackSet::addTrack(const double *X, const double *Y, int numPoints) {
+    if (blocks.empty() || blocks.back().tracks == TRACK_LANES) {
+        TrackBlock block;
+        block.tracks = 0;
+        block.maxPoints = 0;
+        std::fill(block.NUMPOINTS, block.NUMPOINTS + TRACK_LANES, 0);
+        blocks.push_back(block);
+    }
+    TrackBlock &block = blocks.back();
+    if (numPoints > block.maxPoints) {
+        // Interleaved layout keeps its stride, so growing only appends zero padded points
+        block.X.resize((size_t)numPoints * TRACK_LANES, 0.0);
+        block.Y.resize((size_t)numPoints * TRACK_LANES, 0.0);
+        block.maxPoints = numPoints;
+    }
+
+    int lane = block.tracks++;
+    block.NUMPOINTS[lane] = numPoints;
+    for (int i = 0; i < numPoints; i++) {
+        block.X[(size_t)i * TRACK_LANES + lane] = X[i];
+        block.Y[(size_t)i * TRACK_LANES + lane] = Y[i];
+    }
+    return (int)(blocks.size() - 1) * TRACK_LANES + lane;
+}
+
+int MultiTrackSet::size() const {
+    if (blocks.empty()) return 0;
+    return (int)(blocks.size() - 1) * TRACK_LANES + blocks.back().tracks;
+}
+
+void MultiTrackSet::clear() {
+    blocks.clear();
+}
+
+/** evaluate
+ * Computes the CMV of every track in the set, one block of TRACK_LANES tracks at a time.
+ *
+ * @param params Parameters_t with the LIC thresholds and separations shared by all tracks
+ *
+ * @return CMV bitmask of each track, in the order the tracks were added
+ */
+std::vector<uint16_t> MultiTrackSet::evaluate(const Parameters_t &params) const {
+    std::vector<uint16_t> masks(size());
+    for (size_t b = 0; b < blocks.size(); b++) {
+        evaluateTrackBlock(blocks[b], params, masks.data() + b * TRACK_LANES);
+    }
+    return masks;
+}
+
+static_assert(TRACK_LANES % 4 == 0, "lane compares load whole vectors");
+
+// Tolerance of doubleCompare
+static const double LANE_TOLERANCE = 0.000001;
+
+// Lane mask with a bit for every lane of a block
+static const unsigned ALL_LANES = (1u << TRACK_LANES) - 1;
+
+/** compareLanes
+ * Compares the value of every lane with a threshold the way doubleCompare does. Uses AVX or SSE2
+ * when the compiler targets them, one compare and movemask per vector, other targets compare one
+ * lane at a time. The compares are ordered, so a NaN lane is neither near nor below, which is GT
+ * in doubleCompare.
+ *
+ * @param q Value of each lane, TRACK_LANES values
+ * @param threshold Threshold shared by all lanes
+ * @param near Output, lane mask of the values within the tolerance of the threshold
+ * @param below Output, lane mask of the values below the threshold
+ */
+static void compareLanes(const double *q, double threshold, unsigned &near, unsigned &below) {
+    near = 0;
+    below = 0;
+#if defined(__AVX__)
+    __m256d t = _mm256_set1_pd(threshold), tolerance = _mm256_set1_pd(LANE_TOLERANCE), sign = _mm256_set1_pd(-0.0);
+    for (int lane = 0; lane < TRACK_LANES; lane += 4) {
+        __m256d v = _mm256_loadu_pd(q + lane);
+        __m256d distance = _mm256_andnot_pd(sign, _mm256_sub_pd(v, t));
+        near |= (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(distance, tolerance, _CMP_LT_OQ)) << lane;
+        below |= (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(v, t, _CMP_LT_OQ)) << lane;
+    }
+#elif defined(__SSE2__)
+    __m128d t = _mm_set1_pd(threshold), tolerance = _mm_set1_pd(LANE_TOLERANCE), sign = _mm_set1_pd(-0.0);
+    for (int lane = 0; lane < TRACK_LANES; lane += 2) {
+        __m128d v = _mm_loadu_pd(q + lane);
+        __m128d distance = _mm_andnot_pd(sign, _mm_sub_pd(v, t));
+        near |= (unsigned)_mm_movemask_pd(_mm_cmplt_pd(distance, tolerance)) << lane;
+        below |= (unsigned)_mm_movemask_pd(_mm_cmplt_pd(v, t)) << lane;
+    }
+#else
+    for (int lane = 0; lane < TRACK_LANES; lane++) {
+        near |= (unsigned)(std::fabs(q[lane] - threshold) < LANE_TOLERANCE) << lane;
+        below |= (unsigned)(q[lane] < threshold) << lane;
+    }
+#endif
+}
+
+// Lane mask of the values doubleCompare finds GT the threshold
+static unsigned lanesGreater(const double *q, double threshold) {
+    unsigned near, below;
+    compareLanes(q, threshold, near, below);
+    return ~(near | below) & ALL_LANES;
+}
+
+// Lane mask of the values doubleCompare finds LT the threshold
+static unsigned lanesLess(const double *q, double threshold) {
+    unsigned near, below;
+    compareLanes(q, threshold, near, below);
+    return below & ~near;
+}
+
+// Lane mask of a[lane] > b[lane], ordered so NaN lanes are not set
+static unsigned lanesAbove(const double *a, const double *b) {
+    unsigned above = 0;
+#if defined(__AVX__)
+    for (int lane = 0; lane < TRACK_LANES; lane += 4) {
+        __m256d gt = _mm256_cmp_pd(_mm256_loadu_pd(a + lane), _mm256_loadu_pd(b + lane), _CMP_GT_OQ);
+        above |= (unsigned)_mm256_movemask_pd(gt) << lane;
+    }
+#elif defined(__SSE2__)
+    for (int lane = 0; lane < TRACK_LANES; lane += 2) {
+        above |= (unsigned)_mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(a + lane), _mm_loadu_pd(b + lane))) << lane;
+    }
+#else
+    for (int lane = 0; lane < TRACK_LANES; lane++) {
+        above |= (unsigned)(a[lane] > b[lane]) << lane;
+    }
+#endif
+    return above;
+}
+
+// Lane mask of the lanes whose window flags hold bit
+static unsigned lanesWithFlag(const unsigned *flags, unsigned bit) {
+    unsigned lanes = 0;
+    for (int lane = 0; lane < TRACK_LANES; lane++) {
+        lanes |= (unsigned)((flags[lane] & bit) != 0) << lane;
+    }
+    return lanes;
+}
+
+/*
+ * Flags of window i of one LIC for every lane of a block, as one lane mask per flag bit. Point i
+ * of all lanes is one contiguous row, so each LIC first fills an array with its quantity for all
+ * lanes (a distance, an area, the vectors of an angle) in a loop the compiler vectorises, then
+ * compares the whole array against the thresholds with compareLanes. The acos of LICs 2 and 9,
+ * the quadrant count of LIC 4 and the triangles of LICs 8 and 13, which take hypot and pick a side
+ * by branching, are evaluated one lane at a time.
+ */
+template <int LIC>
+static void windowLanes(const TrackBlock &block, const Parameters_t &params, int i, unsigned *raised) {
+    const double *X = block.X.data();
+    const double *Y = block.Y.data();
+    double q[TRACK_LANES];
+    unsigned flags[TRACK_LANES];
+    raised[0] = 0;
+    raised[1] = 0;
+
+    if constexpr (LIC == 0 || LIC == 1) {
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            q[lane] = consecutiveDistance(LanePoints{X + lane, Y + lane}, i);
+        }
+        if (LIC == 0) {
+            raised[0] = lanesGreater(q, params.LENGTH1);
+        } else {
+            double diameter[TRACK_LANES];
+            std::fill(diameter, diameter + TRACK_LANES, 2 * params.RADIUS1);
+            raised[0] = lanesAbove(q, diameter);
+        }
+    } else if constexpr (LIC == 2) {
+        const double *a = X + i * TRACK_LANES, *b = a + TRACK_LANES, *c = b + TRACK_LANES;
+        const double *ay = Y + i * TRACK_LANES, *by = ay + TRACK_LANES, *cy = by + TRACK_LANES;
+        double v1x[TRACK_LANES], v1y[TRACK_LANES], v2x[TRACK_LANES], v2y[TRACK_LANES], m2[TRACK_LANES];
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            v1x[lane] = a[lane] - b[lane];
+            v1y[lane] = ay[lane] - by[lane];
+            v2x[lane] = c[lane] - b[lane];
+            v2y[lane] = cy[lane] - by[lane];
+            q[lane] = std::sqrt(v1x[lane] * v1x[lane] + v1y[lane] * v1y[lane]);
+            m2[lane] = std::sqrt(v2x[lane] * v2x[lane] + v2y[lane] * v2y[lane]);
+        }
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            flags[lane] = lic2Flags(params, v1x[lane], v1y[lane], v2x[lane], v2y[lane], q[lane], m2[lane]);
+        }
+        raised[0] = lanesWithFlag(flags, 1);
+    } else if constexpr (LIC == 3 || LIC == 10 || LIC == 14) {
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            LanePoints pts = {X + lane, Y + lane};
+            q[lane] = LIC == 3 ? consecutiveTriangleArea(pts, i) : separatedTriangleArea(params, pts, i);
+        }
+        raised[0] = lanesGreater(q, params.AREA1);
+        if (LIC == 14) raised[1] = lanesLess(q, params.AREA2);
+    } else if constexpr (LIC == 4) {
+        unsigned quads[TRACK_LANES] = {};
+        for (int j = i; j < i + params.Q_PTS; j++) {
+            const double *x = X + j * TRACK_LANES, *y = Y + j * TRACK_LANES;
+            for (int lane = 0; lane < TRACK_LANES; lane++) {
+                // 1 << pointQuadrant(x, y) as selects, lanes have no variable shift before AVX2
+                quads[lane] |= y[lane] >= 0 ? (x[lane] >= 0 ? 1u : 2u) : (x[lane] <= 0 ? 4u : 8u);
+            }
+        }
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            unsigned seen = quads[lane];
+            int count = (seen & 1) + (seen >> 1 & 1) + (seen >> 2 & 1) + (seen >> 3 & 1);
+            flags[lane] = params.QUADS < count;
+        }
+        raised[0] = lanesWithFlag(flags, 1);
+    } else if constexpr (LIC == 5 || LIC == 11) {
+        // X[i] > X[j] is X[j] - X[i] < 0 for LIC 11 as well, see anyDescendingPair
+        int j = i + (LIC == 5 ? 1 : params.G_PTS + 1);
+        raised[0] = lanesAbove(X + i * TRACK_LANES, X + j * TRACK_LANES);
+    } else if constexpr (LIC == 6) {
+        // Both distances of lic6Window for every lane, the first and last point decide which one counts
+        int end = i + params.N_PTS - 1;
+        const double *first = X + i * TRACK_LANES, *firstY = Y + i * TRACK_LANES;
+        const double *last = X + end * TRACK_LANES, *lastY = Y + end * TRACK_LANES;
+        double a[TRACK_LANES], b[TRACK_LANES], c[TRACK_LANES], fromPoint[TRACK_LANES];
+        unsigned coincide = 0;
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            a[lane] = lastY[lane] - firstY[lane];
+            b[lane] = last[lane] - first[lane];
+            c[lane] = last[lane] * firstY[lane] - lastY[lane] * first[lane];
+            q[lane] = std::sqrt(a[lane] * a[lane] + b[lane] * b[lane]);
+        }
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            coincide |= (unsigned)(doubleCompare(first[lane], last[lane]) == EQ && doubleCompare(firstY[lane], lastY[lane]) == EQ) << lane;
+        }
+        for (int j = i + 1; j < end; j++) {
+            const double *x = X + j * TRACK_LANES, *y = Y + j * TRACK_LANES;
+            double fromLine[TRACK_LANES];
+            for (int lane = 0; lane < TRACK_LANES; lane++) {
+                double dx = x[lane] - first[lane], dy = y[lane] - firstY[lane];
+                fromPoint[lane] = std::sqrt(dx * dx + dy * dy);
+                fromLine[lane] = std::fabs((a[lane] * x[lane] - b[lane] * y[lane] + c[lane]) / q[lane]);
+            }
+            raised[0] |= (lanesGreater(fromPoint, params.DIST) & coincide) | (lanesGreater(fromLine, params.DIST) & ~coincide);
+        }
+    } else if constexpr (LIC == 7 || LIC == 12) {
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            LanePoints pts = {X + lane, Y + lane};
+            int j = i + params.K_PTS + 1;
+            q[lane] = LIC == 7 ? separatedDistance(params, pts, i) : std::hypot(pts.x(j) - pts.x(i), pts.y(j) - pts.y(i));
+        }
+        raised[0] = lanesGreater(q, params.LENGTH1);
+        if (LIC == 12) raised[1] = lanesLess(q, params.LENGTH2);
+    } else if constexpr (LIC == 9) {
+        const double *a = X + i * TRACK_LANES, *ay = Y + i * TRACK_LANES;
+        const double *b = a + (params.C_PTS + 1) * TRACK_LANES, *by = ay + (params.C_PTS + 1) * TRACK_LANES;
+        const double *c = b + (params.D_PTS + 1) * TRACK_LANES, *cy = by + (params.D_PTS + 1) * TRACK_LANES;
+        double bax[TRACK_LANES], bay[TRACK_LANES], bcx[TRACK_LANES], bcy[TRACK_LANES], mc[TRACK_LANES];
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            bax[lane] = a[lane] - b[lane];
+            bay[lane] = ay[lane] - by[lane];
+            bcx[lane] = c[lane] - b[lane];
+            bcy[lane] = cy[lane] - by[lane];
+            q[lane] = std::sqrt(bax[lane] * bax[lane] + bay[lane] * bay[lane]);
+            mc[lane] = std::sqrt(bcx[lane] * bcx[lane] + bcy[lane] * bcy[lane]);
+        }
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            // Skip lanes where point A or C is EQ to the vertex B, as lic9Window does
+            bool vertex = (doubleCompare(a[lane], b[lane]) == EQ && doubleCompare(ay[lane], by[lane]) == EQ)
+                       || (doubleCompare(b[lane], c[lane]) == EQ && doubleCompare(by[lane], cy[lane]) == EQ);
+            flags[lane] = vertex ? 0 : lic9Flags(params, bax[lane], bay[lane], bcx[lane], bcy[lane], q[lane], mc[lane]);
+        }
+        raised[0] = lanesWithFlag(flags, 1);
+    } else {
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            flags[lane] = licWindowFlags<LIC>(params, LanePoints{X + lane, Y + lane}, i);
+        }
+        raised[0] = lanesWithFlag(flags, 1);
+        raised[1] = lanesWithFlag(flags, 2);
+    }
+}
+
+/*
+ * Scans the windows of one LIC for all lanes of a block in lockstep. Every lane evaluates window i
+ * even when it is past the end of its own track (the padding keeps the reads in bounds), and the
+ * result is masked out with the lanes still in range instead of branching. The scan stops once
+ * every lane has either raised its required flags or run out of windows.
+ *
+ * Returns the lane mask of the lanes where the LIC is true.
+ */
+template <int LIC>
+static unsigned scanLanes(const TrackBlock &block, const Parameters_t &params) {
+    int count[TRACK_LANES];
+    int maxCount = 0;
+    Parameters_t laneParams = params;
+    for (int lane = 0; lane < TRACK_LANES; lane++) {
+        laneParams.NUMPOINTS = lane < block.tracks ? block.NUMPOINTS[lane] : 0;
+        count[lane] = licWindowCount(LIC, laneParams);
+        maxCount = std::max(maxCount, count[lane]);
+    }
+
+    // Lanes that raised flag bit 0 and flag bit 1 in some window
+    unsigned raised[2] = {0, 0};
+    unsigned met = 0;
+    for (int i = 0; i < maxCount; i++) {
+        unsigned inRange = 0, remaining = 0;
+        for (int lane = 0; lane < TRACK_LANES; lane++) {
+            inRange |= (unsigned)(i < count[lane]) << lane;
+            remaining |= (unsigned)(i + 1 < count[lane]) << lane;
+        }
+
+        unsigned window[2];
+        windowLanes<LIC>(block, params, i, window);
+        raised[0] |= window[0] & inRange;
+        raised[1] |= window[1] & inRange;
+        met = licRequiredFlags(LIC) == 3 ? raised[0] & raised[1] : raised[0];
+        if ((remaining & ~met) == 0) break;
+    }
+    return met;
+}
+
+template <int... LICS>
+static void scanAllLanes(const TrackBlock &block, const Parameters_t &params, uint16_t *masks,
+                         std::integer_sequence<int, LICS...>) {
+    auto scan = [&](int lic, auto scanner) {
+        unsigned met = scanner(block, params);
+        for (int lane = 0; lane < block.tracks; lane++) {
+            masks[lane] |= (met >> lane & 1) << lic;
+        }
+    };
+    (scan(LICS, scanLanes<LICS>), ...);
+}
+
+/** evaluateTrackBlock
+ * Evaluates all 15 LICs for every track in a block.
+ *
+ * @param block TrackBlock with up to TRACK_LANES interleaved tracks
+ * @param params Parameters_t with the shared LIC thresholds and separations
+ * @param masks Output, one CMV bitmask per lane in use
+ */
+void evaluateTrackBlock(const TrackBlock &block, const Parameters_t &params, uint16_t *masks) {
+    std::fill(masks, masks + block.tracks, 0);
+    scanAllLanes(block, params, masks, std::make_integer_sequence<int, 15>());
+}
@@ -0,0 +1,339 @@
+#include "../include/parallel.hpp"
+#include "../include/context.hpp"
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Pairs compared by anyDescendingPair between two polls of the token
+static const int DESCENDING_CHUNK = 4096;
+
+// Flags of windows [first, last) of a LIC, polling token between blocks. False in completed if cancelled
+template <int LIC>
+static unsigned cancellableScan(const Parameters_t &params, int first, int last, const CancellationToken &token, bool &completed) {
+    const unsigned required = licRequiredFlags(LIC);
+    completed = false;
+
+    if (LIC == 5 || LIC == 11) {
+        int lag = LIC == 5 ? 1 : params.G_PTS + 1;
+        for (int i = first; i < last; i += DESCENDING_CHUNK) {
+            if (token.cancelled()) return 0;
+            if (anyDescendingPair(params.X + i, lag, std::min(DESCENDING_CHUNK, last - i))) {
+                completed = true;
+                return required;
+            }
+        }
+        completed = true;
+        return 0;
+    }
+
+    ArrayPoints pts = {params.X, params.Y};
+    unsigned flags = 0;
+    for (int i = first; i < last; i += KERNEL_BLOCK) {
+        if (token.cancelled()) return 0;
+        flags |= licScanBlocks<LIC>(params, pts, i, std::min(i + KERNEL_BLOCK, last));
+        if (flags == required) break;
+    }
+    completed = true;
+    return flags;
+}
+
+template <int... LIC>
+static unsigned cancellableDispatch(int lic, const Parameters_t &params, int first, int last, const CancellationToken &token,
+                                    bool &completed, std::integer_sequence<int, LIC...>) {
+    unsigned flags = 0;
+    ((lic == LIC ? (flags = cancellableScan<LIC>(params, first, last, token, completed), true) : false) || ...);
+    return flags;
+}
+
+// Runtime dispatch of cancellableScan
+static unsigned cancellableRange(int lic, const Parameters_t &params, int first, int last, const CancellationToken &token, bool &completed) {
+    return cancellableDispatch(lic, params, first, last, token, completed, std::make_integer_sequence<int, 15>());
+}
+
+/** cancellableLic
+ * Evaluates one LIC like evaluateLic, checking the token before every block of KERNEL_BLOCK
+ * windows (LICs 5 and 11: DESCENDING_CHUNK pairs).
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the points
+ * @param token Token polled between blocks
+ * @param completed Set to true if the LIC ran to its result, false if it was cancelled
+ *
+ * @return boolean: the LIC result, false when cancelled
+ */
+bool cancellableLic(int lic, const Parameters_t &params, const CancellationToken &token, bool &completed) {
+    unsigned flags = cancellableRange(lic, params, 0, licWindowCount(lic, params), token, completed);
+    return completed && flags == licRequiredFlags(lic);
+}
+
+/** decideParallel
+ * Runs the LICs of a plan on worker threads with early cancellation, see parallel.hpp.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param X X coordinates of the points
+ * @param Y Y coordinates of the points
+ * @param numPoints Number of points
+ * @param workers Number of threads, at most 15 are used and the caller runs one of them
+ * @param token Token of this decision, cancelled when the launch decision is settled
+ *
+ * @return ParallelDecision with the launch decision and the LICs that finished
+ */
+ParallelDecision decideParallel(const DecidePlan &plan, const double *X, const double *Y, int numPoints,
+                                int workers, CancellationToken &token) {
+    Parameters_t params = plan.params;
+    params.NUMPOINTS = numPoints;
+    params.X = const_cast<double *>(X);
+    params.Y = const_cast<double *>(Y);
+
+    std::atomic<int> nextLic{0};
+    // Bits 0-14 known, bits 16-30 the CMV, updated together so settledLaunch sees a consistent pair
+    std::atomic<uint32_t> state{0};
+    std::atomic<int> settled{settledLaunch(0, 0, plan.LCM, plan.PUV)};
+    if (settled >= 0) token.cancel();
+
+    auto work = [&]() {
+        for (int lic = nextLic++; lic < 15 && !token.cancelled(); lic = nextLic++) {
+            bool completed;
+            bool result = cancellableLic(lic, params, token, completed);
+            if (!completed) break;
+            uint32_t bits = (1u << lic) | (result ? 1u << (16 + lic) : 0);
+            uint32_t now = state.fetch_or(bits) | bits;
+            int outcome = settledLaunch(now & 0x7fff, now >> 16, plan.LCM, plan.PUV);
+            if (outcome >= 0) {
+                int unsettled = -1;
+                settled.compare_exchange_strong(unsettled, outcome);
+                token.cancel();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < std::min(workers, 15) && !token.cancelled(); i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : threads) thread.join();
+
+    ParallelDecision decision;
+    uint32_t done = state.load();
+    decision.known = done & 0x7fff;
+    for (int lic = 0; lic < 15; lic++) {
+        decision.CMV[lic] = done >> (16 + lic) & 1;
+    }
+    decision.launch = settled.load() == 1;
+    return decision;
+}
+
+// Progress of one LIC in decideParallel on a pool, on its own cache line since its chunks update it concurrently
+struct alignas(64) LicProgress {
+    std::atomic<unsigned> flags;            // Flags found so far
+    std::atomic<int> chunksLeft;            // Chunks not finished
+};
+
+// Shared state of the chunk tasks of one decideParallel on a pool
+typedef struct {
+    const DecidePlan *plan;
+    Parameters_t params;
+    CancellationToken *token;
+    int count[15];                          // Windows of each LIC
+    LicProgress progress[15];
+    alignas(64) std::atomic<uint32_t> state;    // As in decideParallel: known bits and CMV bits
+    std::atomic<int> settled;
+} ChunkedDecision;
+
+// Records a LIC result once and cancels the token when that settles the launch decision
+static void finishLic(ChunkedDecision &decision, int lic, bool result) {
+    uint32_t bit = 1u << lic;
+    uint32_t bits = bit | (result ? 1u << (16 + lic) : 0);
+    uint32_t before = decision.state.fetch_or(bits);
+    if (before & bit) return;
+    uint32_t now = before | bits;
+    int outcome = settledLaunch(now & 0x7fff, now >> 16, decision.plan->LCM, decision.plan->PUV);
+    if (outcome >= 0) {
+        int unsettled = -1;
+        decision.settled.compare_exchange_strong(unsettled, outcome);
+        decision.token->cancel();
+    }
+}
+
+// Task index: chunk * 15 + lic
+static void runChunk(void *context, int index) {
+    ChunkedDecision &decision = *(ChunkedDecision *)context;
+    int lic = index % 15, chunk = index / 15;
+    if (decision.token->cancelled() || (decision.state.load() >> lic & 1)) return;
+
+    int first = chunk * SCHEDULER_CHUNK;
+    int last = std::min(first + SCHEDULER_CHUNK, decision.count[lic]);
+    bool completed;
+    unsigned flags = cancellableRange(lic, decision.params, first, last, *decision.token, completed);
+    if (!completed) return;
+
+    unsigned required = licRequiredFlags(lic);
+    unsigned all = decision.progress[lic].flags.fetch_or(flags) | flags;
+    if (all == required) {
+        finishLic(decision, lic, true);
+    } else if (decision.progress[lic].chunksLeft.fetch_sub(1) == 1) {
+        finishLic(decision, lic, false);
+    }
+}
+
+/** decideParallel
+ * Same decision as the overload starting its own threads, but every LIC scan is split into tasks
+ * of SCHEDULER_CHUNK windows on a WorkStealingPool, so a long LIC is spread over several workers
+ * while the cheap LICs finish. A LIC is known true as soon as its chunks together set the required
+ * flags, and false once all its chunks finished without. The first chunk of every LIC is spawned
+ * before the second of any, so all LICs start early and can settle the decision.
+ *
+ * @param pool WorkStealingPool running the chunks
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param X X coordinates of the points
+ * @param Y Y coordinates of the points
+ * @param numPoints Number of points
+ * @param token Token of this decision, cancelled when the launch decision is settled
+ *
+ * @return ParallelDecision with the launch decision and the LICs that finished
+ */
+ParallelDecision decideParallel(WorkStealingPool &pool, const DecidePlan &plan, const double *X, const double *Y, int numPoints,
+                                CancellationToken &token) {
+    ChunkedDecision decision;
+    decision.plan = &plan;
+    decision.params = plan.params;
+    decision.params.NUMPOINTS = numPoints;
+    decision.params.X = const_cast<double *>(X);
+    decision.params.Y = const_cast<double *>(Y);
+    decision.token = &token;
+    decision.state = 0;
+    decision.settled = settledLaunch(0, 0, plan.LCM, plan.PUV);
+    if (decision.settled >= 0) token.cancel();
+
+    int chunks[15], mostChunks = 0;
+    for (int lic = 0; lic < 15; lic++) {
+        decision.count[lic] = std::max(licWindowCount(lic, decision.params), 0);
+        decision.progress[lic].flags = 0;
+        chunks[lic] = (decision.count[lic] + SCHEDULER_CHUNK - 1) / SCHEDULER_CHUNK;
+        decision.progress[lic].chunksLeft = chunks[lic];
+        mostChunks = std::max(mostChunks, chunks[lic]);
+        if (chunks[lic] == 0) finishLic(decision, lic, false);
+    }
+
+    TaskGroup group;
+    for (int chunk = 0; chunk < mostChunks && !token.cancelled(); chunk++) {
+        for (int lic = 0; lic < 15; lic++) {
+            if (chunk < chunks[lic]) pool.spawn(group, &runChunk, &decision, chunk * 15 + lic);
+        }
+    }
+    pool.wait(group);
+
+    ParallelDecision result;
+    uint32_t done = decision.state.load();
+    result.known = done & 0x7fff;
+    for (int lic = 0; lic < 15; lic++) {
+        result.CMV[lic] = done >> (16 + lic) & 1;
+    }
+    result.launch = decision.settled.load() == 1;
+    return result;
+}
+
+static_assert(BATCH_RUN * sizeof(BatchDecision) % 64 == 0, "a run of results fills whole cache lines");
+
+// Results of one run of a batch, staged on the deciding thread before being written out together
+struct alignas(64) BatchStage {
+    BatchDecision results[BATCH_RUN];
+};
+
+// Decides the run of items starting at item first into results
+static void decideRun(const DecidePlan &plan, const PointSetView *items, int count, int first, BatchDecision *results) {
+    static thread_local DecideContext context;
+    static thread_local BatchStage stage;
+    int last = std::min(first + BATCH_RUN, count);
+    for (int k = first; k < last; k++) {
+        BatchDecision &staged = stage.results[k - first];
+        staged.launch = context.decide(plan, items[k].X, items[k].Y, items[k].NUMPOINTS);
+        staged.CMV = context.CMV();
+        staged.FUV = context.FUV();
+    }
+    std::copy(stage.results, stage.results + (last - first), results + first);
+}
+
+/** decideBatch
+ * Decides a batch of point sets on a WorkStealingPool, one task per run of BATCH_RUN point sets.
+ * Each thread keeps its own DecideContext between batches, so after warm-up no task allocates,
+ * and large and small point sets balance over the workers by stealing instead of a fixed split. A
+ * run is decided into a cache-line aligned stage of the deciding thread and copied out in one go.
+ * The results of a run fill whole cache lines, so with results aligned to a cache line no two
+ * threads ever write to the same line, and otherwise only the lines where two runs meet are
+ * shared, written once per run instead of once per point set.
+ *
+ * @param pool WorkStealingPool running the point sets
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param items Point sets
+ * @param count Number of point sets
+ * @param results Output, count entries
+ */
+void decideBatch(WorkStealingPool &pool, const DecidePlan &plan, const PointSetView *items, int count, BatchDecision *results) {
+    auto decideItems = [&](int run) { decideRun(plan, items, count, run * BATCH_RUN, results); };
+    pool.parallelFor((count + BATCH_RUN - 1) / BATCH_RUN, decideItems);
+}
+
+BatchPlacement::BatchPlacement(WorkStealingPool &pool) : pool(pool), pools(pool.workers() + 1) {}
+
+/** BatchPlacement::place
+ * Copies a batch of point sets into per-thread PointSetPools, one task per run of BATCH_RUN point
+ * sets. Each run is copied by the thread that runs its task into that thread's own pool, so the
+ * pages of the copy are first touched there and the kernel places them on that thread's NUMA node.
+ * The thread is remembered as the home of the run. Replaces the previous batch.
+ *
+ * @param items Point sets to copy
+ * @param count Number of point sets
+ */
+void BatchPlacement::place(const PointSetView *items, int count) {
+    for (PointSetPool &points : pools) points.reset();
+    placed.assign(count, PointSetView());
+    homes.assign((count + BATCH_RUN - 1) / BATCH_RUN, -1);
+
+    auto copyRun = [&](int run) {
+        int worker = pool.currentWorker();
+        PointSetPool &points = pools[worker >= 0 ? worker : pool.workers()];
+        int last = std::min((run + 1) * BATCH_RUN, count);
+        for (int k = run * BATCH_RUN; k < last; k++) {
+            placed[k] = points.add(items[k].X, items[k].Y, items[k].NUMPOINTS);
+        }
+        homes[run] = worker;
+    };
+    pool.parallelFor((int)homes.size(), copyRun);
+}
+
+// Context of the runs of decideBatch on a BatchPlacement
+typedef struct {
+    const DecidePlan *plan;
+    const BatchPlacement *placement;
+    BatchDecision *results;
+} PlacedBatch;
+
+static void decidePlacedRun(void *context, int run) {
+    PlacedBatch &batch = *(PlacedBatch *)context;
+    decideRun(*batch.plan, batch.placement->items(), batch.placement->size(), run * BATCH_RUN, batch.results);
+}
+
+/** decideBatch
+ * Decides a batch placed by a BatchPlacement. Every run is queued on the worker that copied it, so
+ * unless it is stolen to balance the load, it is decided next to its memory.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param placement BatchPlacement holding the point sets
+ * @param results Output, placement.size() entries
+ */
+void decideBatch(const DecidePlan &plan, const BatchPlacement &placement, BatchDecision *results) {
+    PlacedBatch batch = {&plan, &placement, results};
+    WorkStealingPool &pool = placement.workerPool();
+    TaskGroup group;
+    for (int run = 0; run < placement.runs(); run++) {
+        int home = placement.home(run);
+        if (home >= 0) {
+            pool.spawnOn(home, group, &decidePlacedRun, &batch, run);
+        } else {
+            pool.spawn(group, &decidePlacedRun, &batch, run);
+        }
+    }
+    pool.wait(group);
+}
@@ -0,0 +1,109 @@
+#include "../include/pool.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+
+// Round bytes up to a multiple of align, a power of two
+static size_t roundUp(size_t bytes, size_t align) {
+    return (bytes + align - 1) & ~(align - 1);
+}
+
+PointSetPool::PointSetPool(size_t blockBytes) : blockBytes(roundUp(blockBytes > 0 ? blockBytes : 1, POOL_ALIGNMENT)) {}
+
+PointSetPool::~PointSetPool() {
+    for (Block &block : blocks) {
+        std::free(block.base);
+    }
+}
+
+/** PointSetPool::carve
+ * Takes bytes (a multiple of POOL_ALIGNMENT) from the current block. When it does not fit, moves
+ * on to the next block kept from an earlier batch, or appends a new block sized for at least
+ * bytes. New blocks are aligned to their own size when that is a power of two, so a default block
+ * can be backed by a single huge page.
+ *
+ * @param bytes Size of the column
+ *
+ * @return start of the column, POOL_ALIGNMENT aligned
+ */
+void *PointSetPool::carve(size_t bytes) {
+    while (current < blocks.size()) {
+        if (offset + bytes <= blocks[current].bytes) {
+            void *column = blocks[current].base + offset;
+            offset += bytes;
+            return column;
+        }
+        current++;
+        offset = 0;
+    }
+
+    size_t size = roundUp(bytes > blockBytes ? bytes : blockBytes, POOL_ALIGNMENT);
+    size_t align = (size & (size - 1)) == 0 ? size : POOL_ALIGNMENT;
+    void *base = std::aligned_alloc(align, size);
+    if (base == nullptr) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    madvise(base, size, MADV_HUGEPAGE);
+#endif
+    blocks.push_back({static_cast<char *>(base), size});
+    current = blocks.size() - 1;
+    offset = bytes;
+    return base;
+}
+
+/** PointSetPool::allocate
+ * Reserves the X and Y columns of a point set, each starting on a POOL_ALIGNMENT boundary.
+ *
+ * @param numPoints Number of points, negative counts as 0
+ *
+ * @return view of the columns, valid until reset()
+ */
+PointSetView PointSetPool::allocate(int numPoints) {
+    if (numPoints < 0) numPoints = 0;
+    size_t column = roundUp(sizeof(double) * numPoints, POOL_ALIGNMENT);
+    PointSetView view;
+    view.NUMPOINTS = numPoints;
+    if (column == 0) {
+        view.X = nullptr;
+        view.Y = nullptr;
+    } else {
+        // One carve for both columns keeps them in the same block
+        char *columns = static_cast<char *>(carve(2 * column));
+        view.X = reinterpret_cast<double *>(columns);
+        view.Y = reinterpret_cast<double *>(columns + column);
+    }
+    sets++;
+    return view;
+}
+
+PointSetView PointSetPool::add(const double *X, const double *Y, int numPoints) {
+    PointSetView view = allocate(numPoints);
+    if (view.NUMPOINTS > 0) {
+        memcpy(view.X, X, sizeof(double) * view.NUMPOINTS);
+        memcpy(view.Y, Y, sizeof(double) * view.NUMPOINTS);
+    }
+    return view;
+}
+
+void PointSetPool::reset() {
+    current = 0;
+    offset = 0;
+    sets = 0;
+}
+
+/** withPoints
+ * Points a copy of params at the columns of a pooled point set, for the functions taking a
+ * Parameters_t.
+ *
+ * @param params Thresholds and separations
+ * @param view Point set from a PointSetPool
+ *
+ * @return params with X, Y and NUMPOINTS from view
+ */
+Parameters_t withPoints(const Parameters_t &params, const PointSetView &view) {
+    Parameters_t pooled = params;
+    pooled.X = view.X;
+    pooled.Y = view.Y;
+    pooled.NUMPOINTS = view.NUMPOINTS;
+    return pooled;
+}
@@ -0,0 +1,99 @@
+#include "../include/range.hpp"
+#include <utility>
+
+// Sizes bits for count windows, all clear
+static void clearBits(WindowBits &bits, int count) {
+    bits.words.assign((count + 63) / 64, 0);
+    bits.rank.assign(bits.words.size() + 1, 0);
+}
+
+static void rankBits(WindowBits &bits) {
+    for (size_t w = 0; w < bits.words.size(); w++) {
+        bits.rank[w + 1] = bits.rank[w] + __builtin_popcountll(bits.words[w]);
+    }
+}
+
+// Set bits before window k
+static int bitsBefore(const WindowBits &bits, int k) {
+    int word = k / 64, offset = k % 64;
+    int before = bits.rank[word];
+    if (offset != 0) before += __builtin_popcountll(bits.words[word] & ((1ull << offset) - 1));
+    return before;
+}
+
+// True if a window in [first, last) has its bit set
+static bool anyBit(const WindowBits &bits, int first, int last) {
+    return bitsBefore(bits, last) > bitsBefore(bits, first);
+}
+
+template <int LIC>
+static void indexLic(const Parameters_t &params, int count, WindowBits *bits) {
+    ArrayPoints pts = {params.X, params.Y};
+    clearBits(bits[0], count);
+    if (licRequiredFlags(LIC) & 2) clearBits(bits[1], count);
+    for (int i = 0; i < count; i++) {
+        unsigned flags = licWindowFlags<LIC>(params, pts, i);
+        if (flags & 1) bits[0].words[i / 64] |= 1ull << (i % 64);
+        if (flags & 2) bits[1].words[i / 64] |= 1ull << (i % 64);
+    }
+    rankBits(bits[0]);
+    if (licRequiredFlags(LIC) & 2) rankBits(bits[1]);
+}
+
+template <int... LIC>
+static void indexAll(const Parameters_t &params, const int *windows, WindowBits (*flags)[2], std::integer_sequence<int, LIC...>) {
+    (indexLic<LIC>(params, windows[LIC], flags[LIC]), ...);
+}
+
+/** RangeIndex::RangeIndex
+ * Evaluates every window of every LIC over the whole recording and keeps one bit per window and
+ * required flag. Takes one pass of computeCMV without early exits, and about one bit per window
+ * and flag of memory.
+ *
+ * @param params Parameters_t with the whole recording, the points must outlive the index
+ */
+RangeIndex::RangeIndex(const Parameters_t &params) : params(params), points(params.NUMPOINTS) {
+    for (int lic = 0; lic < 15; lic++) {
+        windows[lic] = std::max(licWindowCount(lic, params), 0);
+    }
+    indexAll(params, windows, flags, std::make_integer_sequence<int, 15>());
+}
+
+/** RangeIndex::CMV
+ * Computes the CMV of a sub-range of the recording in constant time per LIC. The input checks are
+ * those of hi - lo points, so a range too short for a LIC's separations leaves it false as
+ * computeCMV would.
+ *
+ * @param lo First point of the range
+ * @param hi One past the last point of the range
+ *
+ * @return CMV where index i is the result of LIC i, all false for an empty or invalid range
+ */
+std::array<bool, 15> RangeIndex::CMV(int lo, int hi) const {
+    std::array<bool, 15> cmv{};
+    if (lo < 0 || hi > points || lo >= hi) return cmv;
+
+    Parameters_t range = params;
+    range.NUMPOINTS = hi - lo;
+    for (int lic = 0; lic < 15; lic++) {
+        // Input checks only get stricter with fewer points, so the windows are all indexed
+        int count = std::min(licWindowCount(lic, range), windows[lic] - lo);
+        if (count <= 0) continue;
+        cmv[lic] = anyBit(flags[lic][0], lo, lo + count);
+        if (licRequiredFlags(lic) & 2) cmv[lic] = cmv[lic] && anyBit(flags[lic][1], lo, lo + count);
+    }
+    return cmv;
+}
+
+/** RangeIndex::decide
+ * Launch decision of a sub-range of the recording.
+ *
+ * @param plan DecidePlan with the launch configuration, its parameters are those of the index
+ * @param lo First point of the range
+ * @param hi One past the last point of the range
+ *
+ * @return boolean: launch decision
+ */
+bool RangeIndex::decide(const DecidePlan &plan, int lo, int hi) const {
+    return launchDecision(generateFinalUnlockingVector(CMV(lo, hi), plan.LCM, plan.PUV));
+}
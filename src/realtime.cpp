@@ -0,0 +1,184 @@
+#include "../include/realtime.hpp"
+#include "../include/lcm.hpp"
+#include "../include/lic_windows.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
+// OR of the flags of every window [0, count), never stopping early
+template <int LIC>
+static unsigned fullScan(const Parameters_t &params, const ArrayPoints &pts, int count) noexcept {
+    unsigned flags = 0;
+    for (int i = 0; i < count; i++) {
+        flags |= licWindowFlags<LIC>(params, pts, i);
+    }
+    return flags;
+}
+
+typedef unsigned (*FullScan)(const Parameters_t &params, const ArrayPoints &pts, int count) noexcept;
+
+static const FullScan fullScans[15] = {
+    &fullScan<0>, &fullScan<1>, &fullScan<2>, &fullScan<3>, &fullScan<4>,
+    &fullScan<5>, &fullScan<6>, &fullScan<7>, &fullScan<8>, &fullScan<9>,
+    &fullScan<10>, &fullScan<11>, &fullScan<12>, &fullScan<13>, &fullScan<14>,
+};
+
+static bool realtimeLic(int lic, const Parameters_t &params, const ArrayPoints &pts) noexcept {
+    int count = licWindowCount(lic, params);
+    if (count <= 0) return false;
+    return fullScans[lic](params, pts, count) == licRequiredFlags(lic);
+}
+
+static RealtimeDecision realtimeStage(const DecidePlan &plan, const std::array<bool, 15> &CMV) noexcept {
+    RealtimeDecision decision;
+    decision.CMV = CMV;
+    decision.FUV = generateFinalUnlockingVector(CMV, plan.LCM, plan.PUV);
+    decision.launch = launchDecision(decision.FUV);
+    return decision;
+}
+
+/** decideRealtime
+ * Decides a point set with full window scans. The CMV, FUV and launch decision are those of the
+ * pipeline; only the time taken no longer depends on where, or whether, a LIC first triggers.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param X X coordinates
+ * @param Y Y coordinates
+ * @param numPoints Number of points
+ *
+ * @return RealtimeDecision with the CMV, FUV and launch decision
+ */
+RealtimeDecision decideRealtime(const DecidePlan &plan, const double *X, const double *Y, int numPoints) noexcept {
+    Parameters_t params = plan.params;
+    params.X = const_cast<double *>(X);
+    params.Y = const_cast<double *>(Y);
+    params.NUMPOINTS = numPoints;
+    ArrayPoints pts = {X, Y};
+
+    std::array<bool, 15> CMV;
+    for (int lic = 0; lic < 15; lic++) {
+        CMV[lic] = realtimeLic(lic, params, pts);
+    }
+    return realtimeStage(plan, CMV);
+}
+
+/** licWindowCost
+ * Points one window reads at most: Q_PTS for LIC 4, the N_PTS points of LIC 6 when none is far
+ * enough from the line, at most 3 otherwise.
+ *
+ * @param lic LIC number, 0 to 14
+ * @param params Parameters_t with the window parameters
+ *
+ * @return long long: points read per window, at least 1
+ */
+long long licWindowCost(int lic, const Parameters_t &params) noexcept {
+    switch (lic) {
+    case 4: return std::max(params.Q_PTS, 1);
+    case 6: return std::max(params.N_PTS, 1);
+    case 0:
+    case 5:
+    case 7:
+    case 11:
+    case 12: return 2;
+    default: return 3;
+    }
+}
+
+long long licCostBound(int lic, const Parameters_t &params, int numPoints) noexcept {
+    Parameters_t sized = params;
+    sized.NUMPOINTS = numPoints;
+    long long windows = std::max(licWindowCount(lic, sized), 0);
+    return windows * licWindowCost(lic, params) + 1;
+}
+
+/** stressCorpus
+ * Adds point sets of numPoints points built to reach the slowest path of each window: coincident
+ * points for the line distance loop of LIC 6, collinear points so that loop never exits early,
+ * subnormal coordinates, which are slow on many FPUs, NaN and infinite coordinates, values near the
+ * overflow limit and a random walk.
+ *
+ * @param pool PointSetPool holding the point sets
+ * @param numPoints Points of each point set
+ * @param corpus Point sets are appended to it
+ */
+void stressCorpus(PointSetPool &pool, int numPoints, std::vector<PointSetView> &corpus) {
+    const int sets = 6;
+    for (int set = 0; set < sets; set++) {
+        PointSetView view = pool.allocate(numPoints);
+        unsigned state = 12345 + set;
+        for (int i = 0; i < numPoints; i++) {
+            state = state * 1103515245 + 12345;
+            double noise = (state >> 8) / double(1 << 24) - 0.5;
+            switch (set) {
+            case 0: view.X[i] = 0; view.Y[i] = 0; break;
+            case 1: view.X[i] = i; view.Y[i] = 2.0 * i; break;
+            case 2: view.X[i] = DBL_TRUE_MIN * (i % 7); view.Y[i] = DBL_TRUE_MIN * (i % 5); break;
+            case 3: view.X[i] = i % 3 == 0 ? NAN : noise; view.Y[i] = i % 5 == 0 ? INFINITY : noise; break;
+            case 4: view.X[i] = DBL_MAX * noise; view.Y[i] = -DBL_MAX * noise; break;
+            default:
+                view.X[i] = (i > 0 ? view.X[i-1] : 0) + noise;
+                view.Y[i] = (i > 0 ? view.Y[i-1] : 0) - noise;
+            }
+        }
+        corpus.push_back(view);
+    }
+}
+
+// Makes a timed result an input of an empty asm statement, so the work producing it is not optimised away
+static inline void keepResult(bool value) {
+    asm volatile("" : : "r"(value));
+}
+
+/** measureWcet
+ * Times every LIC and the unlocking stage of decideRealtime on each point set of a corpus and keeps
+ * the largest time per unit of licCostBound. The clock overhead is included, so the times of small
+ * point sets err on the slow side.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param corpus Point sets
+ * @param count Number of point sets
+ * @param repetitions Times each point set is decided
+ *
+ * @return WcetProfile of the plan on this machine
+ */
+WcetProfile measureWcet(const DecidePlan &plan, const PointSetView *corpus, int count, int repetitions) {
+    typedef std::chrono::steady_clock Clock;
+    WcetProfile profile;
+    profile.nsPerUnit.fill(0);
+    profile.stageNs = 0;
+
+    for (int k = 0; k < count; k++) {
+        Parameters_t params = withPoints(plan.params, corpus[k]);
+        ArrayPoints pts = {corpus[k].X, corpus[k].Y};
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            std::array<bool, 15> CMV;
+            for (int lic = 0; lic < 15; lic++) {
+                Clock::time_point start = Clock::now();
+                CMV[lic] = realtimeLic(lic, params, pts);
+                double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                double perUnit = ns / licCostBound(lic, params, params.NUMPOINTS);
+                profile.nsPerUnit[lic] = std::max(profile.nsPerUnit[lic], perUnit);
+            }
+            Clock::time_point start = Clock::now();
+            keepResult(realtimeStage(plan, CMV).launch);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            profile.stageNs = std::max(profile.stageNs, ns);
+        }
+    }
+    return profile;
+}
+
+WcetReport wcetReport(const DecidePlan &plan, int numPoints, const WcetProfile &profile) {
+    WcetReport report;
+    report.totalNs = profile.stageNs;
+    for (int lic = 0; lic < 15; lic++) {
+        report.units[lic] = licCostBound(lic, plan.params, numPoints);
+        report.licNs[lic] = report.units[lic] * profile.nsPerUnit[lic];
+        report.totalNs += report.licNs[lic];
+    }
+    return report;
+}
+
+bool fits(const DecidePlan &plan, int numPoints, const WcetProfile &profile, double budgetNs) {
+    return wcetReport(plan, numPoints, profile).totalNs <= budgetNs;
+}
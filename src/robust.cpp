@@ -0,0 +1,412 @@
+#include "../include/robust.hpp"
+#include "../include/lic_windows.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cfloat>
+#include <limits>
+
+/*
+ * Components an expansion can hold. Every expansion below is nonoverlapping: the bits of its
+ * components occupy disjoint positions, and without overflow or underflow (the precondition of the
+ * exact predicates) those positions lie between 2^(DBL_MIN_EXP - DBL_MANT_DIG), the smallest
+ * denormal, and 2^(DBL_MAX_EXP - 1). One component per bit position, 2098 for IEEE doubles, bounds
+ * any expansion whatever the degree of the polynomial, including the uncompressed results of
+ * growExpansion and scaleExpansion.
+ */
+static const int EXPANSION_CAPACITY = DBL_MAX_EXP - DBL_MIN_EXP + DBL_MANT_DIG;
+static_assert(EXPANSION_CAPACITY == 2098, "expansion capacity assumes IEEE 754 doubles");
+
+static std::atomic<long> exactEvaluations{0};
+
+// x + y = a + b exactly, x = fl(a + b)
+static inline void twoSum(double a, double b, double &x, double &y) {
+    x = a + b;
+    double bVirtual = x - a;
+    double aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+// x + y = a + b exactly, requires |a| >= |b|
+static inline void fastTwoSum(double a, double b, double &x, double &y) {
+    x = a + b;
+    y = b - (x - a);
+}
+
+// x + y = a * b exactly, x = fl(a * b)
+static inline void twoProduct(double a, double b, double &x, double &y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+/*
+ * Exact value as a sum of nonoverlapping doubles in increasing magnitude, with zero components
+ * removed. Supports the +, - and * a predicate polynomial needs.
+ */
+struct Expansion {
+    int size = 0;
+    double terms[EXPANSION_CAPACITY];
+
+    Expansion() {}
+    explicit Expansion(double a) {
+        if (a != 0) append(a);
+    }
+    // Copies only the components in use
+    Expansion(const Expansion &other) : size(other.size) {
+        std::copy(other.terms, other.terms + size, terms);
+    }
+    Expansion &operator=(const Expansion &other) {
+        size = other.size;
+        std::copy(other.terms, other.terms + size, terms);
+        return *this;
+    }
+
+    void append(double a) {
+        assert(size < EXPANSION_CAPACITY);
+        terms[size++] = a;
+    }
+};
+
+// e + b (Shewchuk's GROW-EXPANSION with zero elimination)
+static void growExpansion(const Expansion &e, double b, Expansion &h) {
+    double q = b;
+    h.size = 0;
+    for (int i = 0; i < e.size; i++) {
+        double sum, error;
+        twoSum(q, e.terms[i], sum, error);
+        if (error != 0) h.append(error);
+        q = sum;
+    }
+    if (q != 0) h.append(q);
+}
+
+// Same value in fewer, larger components (Shewchuk's COMPRESS)
+static void compress(Expansion &e) {
+    if (e.size < 2) return;
+    double h[EXPANSION_CAPACITY];
+    int bottom = e.size - 1;
+    double q = e.terms[bottom];
+    for (int i = e.size - 2; i >= 0; i--) {
+        double sum, error;
+        fastTwoSum(q, e.terms[i], sum, error);
+        if (error != 0) {
+            h[bottom--] = sum;
+            q = error;
+        } else {
+            q = sum;
+        }
+    }
+    int top = e.size;
+    e.size = 0;
+    for (int i = bottom + 1; i < top; i++) {
+        double sum, error;
+        fastTwoSum(h[i], q, sum, error);
+        if (error != 0) e.append(error);
+        q = sum;
+    }
+    if (q != 0) e.append(q);
+}
+
+static Expansion operator+(const Expansion &e, const Expansion &f) {
+    Expansion h = e, next;
+    for (int i = 0; i < f.size; i++) {
+        growExpansion(h, f.terms[i], next);
+        h = next;
+    }
+    compress(h);
+    return h;
+}
+
+static Expansion operator-(const Expansion &e) {
+    Expansion h = e;
+    for (int i = 0; i < h.size; i++) h.terms[i] = -h.terms[i];
+    return h;
+}
+
+static Expansion operator-(const Expansion &e, const Expansion &f) {
+    return e + -f;
+}
+
+// e * b (Shewchuk's SCALE-EXPANSION with zero elimination)
+static void scaleExpansion(const Expansion &e, double b, Expansion &h) {
+    h.size = 0;
+    if (e.size == 0 || b == 0) return;
+    double q, error;
+    twoProduct(e.terms[0], b, q, error);
+    if (error != 0) h.append(error);
+    for (int i = 1; i < e.size; i++) {
+        double high, low, sum;
+        twoProduct(e.terms[i], b, high, low);
+        twoSum(q, low, sum, error);
+        if (error != 0) h.append(error);
+        fastTwoSum(high, sum, q, error);
+        if (error != 0) h.append(error);
+    }
+    if (q != 0) h.append(q);
+}
+
+static Expansion operator*(const Expansion &e, const Expansion &f) {
+    Expansion product, scaled;
+    for (int i = 0; i < f.size; i++) {
+        scaleExpansion(e, f.terms[i], scaled);
+        product = product + scaled;
+    }
+    return product;
+}
+
+// The largest component carries the sign
+static int sign(const Expansion &e) {
+    if (e.size == 0) return 0;
+    return e.terms[e.size - 1] > 0 ? 1 : -1;
+}
+
+// Double value with a bound on its distance from the exact value of the same expression
+struct Bounded {
+    double value;
+    double error;
+
+    explicit Bounded(double a) : value(a), error(0) {}
+    Bounded(double value, double error) : value(value), error(error) {}
+};
+
+// Bound on the rounding error of one operation with result v, u(1 + u) |v|
+static const double ROUNDOFF = DBL_EPSILON / 2 * (1 + DBL_EPSILON);
+
+static inline Bounded operator+(Bounded a, Bounded b) {
+    double v = a.value + b.value;
+    return Bounded(v, a.error + b.error + std::fabs(v) * ROUNDOFF);
+}
+
+static inline Bounded operator-(Bounded a) {
+    return Bounded(-a.value, a.error);
+}
+
+static inline Bounded operator-(Bounded a, Bounded b) {
+    double v = a.value - b.value;
+    return Bounded(v, a.error + b.error + std::fabs(v) * ROUNDOFF);
+}
+
+static inline Bounded operator*(Bounded a, Bounded b) {
+    double v = a.value * b.value;
+    // The denormal term covers the absolute error of an underflowing product
+    double error = std::fabs(a.value) * b.error + std::fabs(b.value) * a.error + a.error * b.error
+                 + std::fabs(v) * ROUNDOFF + std::numeric_limits<double>::denorm_min();
+    return Bounded(v, error);
+}
+
+static int sign(const Bounded &b) {
+    // The bound itself is computed with rounding, the factor covers that for the short polynomials here
+    double margin = b.error * (1 + 64 * DBL_EPSILON);
+    if (b.value > margin) return 1;
+    if (b.value < -margin) return -1;
+    return 0;
+}
+
+/** robustSign
+ * Sign of a polynomial given as a generic callable that builds it from a number type. The filtered
+ * evaluation decides whenever its value is further from zero than its error bound, the exact
+ * evaluation covers the rest.
+ *
+ * @param polynomial Callable taking a zero of the number type (Bounded or Expansion)
+ *
+ * @return -1, 0 or 1
+ */
+template <typename Polynomial>
+static int robustSign(const Polynomial &polynomial) {
+    Bounded fast = polynomial(Bounded(0));
+    int fastSign = sign(fast);
+    if (fastSign != 0) return fastSign;
+    exactEvaluations.fetch_add(1, std::memory_order_relaxed);
+    return sign(polynomial(Expansion(0)));
+}
+
+int robustOrientation(double ax, double ay, double bx, double by, double cx, double cy) {
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        return (N(bx) - N(ax)) * (N(cy) - N(ay)) - (N(by) - N(ay)) * (N(cx) - N(ax));
+    });
+}
+
+int robustCompareDistance(double ax, double ay, double bx, double by, double length) {
+    if (length < 0) return 1;
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        N dx = N(bx) - N(ax), dy = N(by) - N(ay);
+        return dx * dx + dy * dy - N(length) * N(length);
+    });
+}
+
+int robustCompareLengths(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy) {
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        N abx = N(bx) - N(ax), aby = N(by) - N(ay);
+        N cdx = N(dx) - N(cx), cdy = N(dy) - N(cy);
+        return abx * abx + aby * aby - (cdx * cdx + cdy * cdy);
+    });
+}
+
+int robustCompareLineDistance(double ax, double ay, double bx, double by, double px, double py, double dist) {
+    if (dist < 0) return 1;
+    // distance = |cross| / |ab|, compared squared: cross^2 - dist^2 |ab|^2
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        N abx = N(bx) - N(ax), aby = N(by) - N(ay);
+        N apx = N(px) - N(ax), apy = N(py) - N(ay);
+        N cross = abx * apy - aby * apx;
+        return cross * cross - N(dist) * N(dist) * (abx * abx + aby * aby);
+    });
+}
+
+int robustCompareMidpointDistance(double px, double py, double ax, double ay, double bx, double by, double radius) {
+    if (radius < 0) return 1;
+    // Twice the vector from the midpoint to p is exact without the halving
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        N mx = N(px) + N(px) - N(ax) - N(bx), my = N(py) + N(py) - N(ay) - N(by);
+        N diameter = N(radius) + N(radius);
+        return mx * mx + my * my - diameter * diameter;
+    });
+}
+
+int robustCompareCircumradius(double ax, double ay, double bx, double by, double cx, double cy, double radius) {
+    if (radius < 0) return 1;
+    // R = |ab| |ac| |bc| / (2 |cross|), so R - radius has the sign of |ab|^2 |ac|^2 |bc|^2 - 4 radius^2 cross^2
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        N abx = N(bx) - N(ax), aby = N(by) - N(ay);
+        N acx = N(cx) - N(ax), acy = N(cy) - N(ay);
+        N bcx = N(cx) - N(bx), bcy = N(cy) - N(by);
+        N cross = abx * acy - aby * acx;
+        N diameter = N(radius) + N(radius);
+        return (abx * abx + aby * aby) * (acx * acx + acy * acy) * (bcx * bcx + bcy * bcy)
+             - diameter * diameter * cross * cross;
+    });
+}
+
+int robustCompareDeviation(double ax, double ay, double vx, double vy, double cx, double cy, double cosEpsilon, double sinEpsilon) {
+    // The deviation d = atan2(|cross|, -dot), sin(d - epsilon) = cos(epsilon) |cross| + sin(epsilon) dot
+    double side = robustOrientation(vx, vy, ax, ay, cx, cy);
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        N vax = N(ax) - N(vx), vay = N(ay) - N(vy);
+        N vcx = N(cx) - N(vx), vcy = N(cy) - N(vy);
+        N cross = vax * vcy - vay * vcx;
+        N dot = vax * vcx + vay * vcy;
+        return N(side * cosEpsilon) * cross + N(sinEpsilon) * dot;
+    });
+}
+
+// Sign of (a - v) . (c - v)
+static int robustDotSign(double ax, double ay, double vx, double vy, double cx, double cy) {
+    return robustSign([&](auto zero) {
+        typedef decltype(zero) N;
+        return (N(ax) - N(vx)) * (N(cx) - N(vx)) + (N(ay) - N(vy)) * (N(cy) - N(vy));
+    });
+}
+
+long robustExactEvaluations() {
+    return exactEvaluations.load(std::memory_order_relaxed);
+}
+
+// LIC 6 with exact distances from the line
+static unsigned robustLic6Window(const Parameters_t &params, int i) {
+    const double *X = params.X, *Y = params.Y;
+    int last = i + params.N_PTS - 1;
+    bool coincident = X[i] == X[last] && Y[i] == Y[last];
+    for (int j = i + 1; j < last; j++) {
+        int side = coincident ? robustCompareDistance(X[i], Y[i], X[j], Y[j], params.DIST)
+                              : robustCompareLineDistance(X[i], Y[i], X[last], Y[last], X[j], Y[j], params.DIST);
+        if (side > 0) return 1;
+    }
+    return 0;
+}
+
+// LIC 8 with the same steps as lic8Window, each decided exactly
+static unsigned robustLic8Window(const Parameters_t &params, int i) {
+    const double *X = params.X, *Y = params.Y;
+    int b = i + params.A_PTS + 1;
+    int c = b + params.B_PTS + 1;
+    double diameter = 2 * params.RADIUS1;
+    if (robustCompareDistance(X[i], Y[i], X[b], Y[b], diameter) > 0 ||
+        robustCompareDistance(X[i], Y[i], X[c], Y[c], diameter) > 0 ||
+        robustCompareDistance(X[b], Y[b], X[c], Y[c], diameter) > 0) return 1;
+
+    int abVsAc = robustCompareLengths(X[i], Y[i], X[b], Y[b], X[i], Y[i], X[c], Y[c]);
+    int abVsBc = robustCompareLengths(X[i], Y[i], X[b], Y[b], X[b], Y[b], X[c], Y[c]);
+    int acVsBc = robustCompareLengths(X[i], Y[i], X[c], Y[c], X[b], Y[b], X[c], Y[c]);
+    int apex = i, end1 = b, end2 = c;
+    if (abVsAc > 0 && abVsBc > 0) {
+        apex = c, end1 = i, end2 = b;
+    } else if (abVsAc < 0 && acVsBc > 0) {
+        apex = b, end1 = i, end2 = c;
+    }
+    if (robustCompareMidpointDistance(X[apex], Y[apex], X[end1], Y[end1], X[end2], Y[end2], params.RADIUS1) <= 0) return 0;
+
+    if (robustOrientation(X[i], Y[i], X[b], Y[b], X[c], Y[c]) == 0) return 0;
+    return robustCompareCircumradius(X[i], Y[i], X[b], Y[b], X[c], Y[c], params.RADIUS1) > 0;
+}
+
+// LIC 9 on the angle between BA and BC
+static unsigned robustLic9Window(const Parameters_t &params, int i, double cosEpsilon, double sinEpsilon) {
+    const double *X = params.X, *Y = params.Y;
+    int b = i + params.C_PTS + 1;
+    int c = b + params.D_PTS + 1;
+    if ((X[i] == X[b] && Y[i] == Y[b]) || (X[c] == X[b] && Y[c] == Y[b])) return 0;
+    if (sinEpsilon == 0) {
+        // EPSILON of 0: any bend, or both points on the same side of the vertex
+        return robustOrientation(X[b], Y[b], X[i], Y[i], X[c], Y[c]) != 0 ||
+               robustDotSign(X[i], Y[i], X[b], Y[b], X[c], Y[c]) > 0;
+    }
+    return robustCompareDeviation(X[i], Y[i], X[b], Y[b], X[c], Y[c], cosEpsilon, sinEpsilon) > 0;
+}
+
+// LIC 13 with exact collinearity and circumradius comparisons
+static unsigned robustLic13Window(const Parameters_t &params, int i) {
+    const double *X = params.X, *Y = params.Y;
+    int b = i + params.A_PTS + 1;
+    int c = b + params.B_PTS + 1;
+    if (robustOrientation(X[i], Y[i], X[b], Y[b], X[c], Y[c]) == 0) return 0;
+    unsigned flags = 0;
+    if (robustCompareCircumradius(X[i], Y[i], X[b], Y[b], X[c], Y[c], params.RADIUS1) > 0) flags |= 1;
+    if (robustCompareCircumradius(X[i], Y[i], X[b], Y[b], X[c], Y[c], params.RADIUS2) <= 0) flags |= 2;
+    return flags;
+}
+
+/** computeRobustCMV
+ * Computes the CMV with LICs 6, 8, 9 and 13 decided by the robust predicates. Their geometry is
+ * that of the exact fixed-point mode: comparisons have no tolerance, collinearity is exact and
+ * LIC 9 uses the angle between BA and BC. The other eleven LICs are evaluated as in computeCMV,
+ * and all input checks are those of licWindowCount.
+ *
+ * @param params Parameters_t with points and thresholds
+ *
+ * @return CMV where index i is the result of LIC i
+ */
+std::array<bool, 15> computeRobustCMV(const Parameters_t &params) {
+    std::array<bool, 15> CMV;
+    for (int lic = 0; lic < 15; lic++) {
+        if (lic != 6 && lic != 8 && lic != 9 && lic != 13) CMV[lic] = evaluateLic(lic, params);
+    }
+
+    unsigned flags6 = 0, flags8 = 0, flags9 = 0, flags13 = 0;
+    int count = licWindowCount(6, params);
+    for (int i = 0; i < count && !flags6; i++) flags6 = robustLic6Window(params, i);
+    count = licWindowCount(8, params);
+    for (int i = 0; i < count && !flags8; i++) flags8 = robustLic8Window(params, i);
+
+    count = licWindowCount(9, params);
+    if (count > 0) {
+        // licWindowCount keeps EPSILON within [0, PI], where sin(EPSILON) is 0 only for EPSILON = 0
+        double cosEpsilon = std::cos(params.EPSILON), sinEpsilon = std::sin(params.EPSILON);
+        for (int i = 0; i < count && !flags9; i++) flags9 = robustLic9Window(params, i, cosEpsilon, sinEpsilon);
+    }
+
+    count = licWindowCount(13, params);
+    for (int i = 0; i < count && flags13 != 3; i++) flags13 |= robustLic13Window(params, i);
+
+    CMV[6] = flags6 == 1;
+    CMV[8] = flags8 == 1;
+    CMV[9] = flags9 == 1;
+    CMV[13] = flags13 == 3;
+    return CMV;
+}
@@ -0,0 +1,165 @@
+#include "../include/scheduler.hpp"
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Pool and worker index of the current thread, the index is -1 outside every pool
+static thread_local const WorkStealingPool *currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+WorkStealingPool::WorkStealingPool(int workers, bool pinThreads) {
+    if (workers < 1) workers = 1;
+    for (int i = 0; i < workers; i++) {
+        deques.emplace_back(new WorkerDeque());
+    }
+    for (int i = 0; i < workers; i++) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i, pinThreads);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        running = false;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads) thread.join();
+}
+
+int WorkStealingPool::currentWorker() const {
+    return currentPool == this ? ::currentWorker : -1;
+}
+
+/** WorkStealingPool::spawn
+ * Queues a task. A worker of this pool pushes to the back of its own deque, any other thread to
+ * the deques in turn.
+ *
+ * @param group TaskGroup the task counts towards until it has run
+ * @param run Function of the task
+ * @param context First argument of run
+ * @param index Second argument of run
+ */
+void WorkStealingPool::spawn(TaskGroup &group, void (*run)(void *context, int index), void *context, int index) {
+    int worker = currentWorker();
+    spawnOn(worker >= 0 ? worker : (int)(nextDeque++ % deques.size()), group, run, context, index);
+}
+
+/** WorkStealingPool::spawnOn
+ * Pushes a task to the back of the deque of a worker, then wakes one sleeping worker and any thread
+ * sleeping in wait(), which can help run it.
+ *
+ * @param worker Worker whose deque gets the task, 0 to workers() - 1
+ * @param group TaskGroup the task counts towards until it has run
+ * @param run Function of the task
+ * @param context First argument of run
+ * @param index Second argument of run
+ */
+void WorkStealingPool::spawnOn(int worker, TaskGroup &group, void (*run)(void *context, int index), void *context, int index) {
+    group.count.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> guard(deques[worker]->lock);
+        deques[worker]->tasks.push_back({run, context, index, &group});
+    }
+    bool waiters;
+    {
+        // Taken so a worker between its last check and its wait cannot miss the wake-up
+        std::lock_guard<std::mutex> guard(sleepLock);
+        queued.fetch_add(1, std::memory_order_release);
+        waiters = waiting > 0;
+    }
+    wake.notify_one();
+    if (waiters) progress.notify_all();
+}
+
+bool WorkStealingPool::popOwn(int worker, Task &task) {
+    WorkerDeque &deque = *deques[worker];
+    std::lock_guard<std::mutex> guard(deque.lock);
+    if (deque.tasks.empty()) return false;
+    task = deque.tasks.back();
+    deque.tasks.pop_back();
+    return true;
+}
+
+/** WorkStealingPool::steal
+ * Takes the oldest task of the first non-empty deque, starting after the thief's own so thieves
+ * spread over the victims.
+ *
+ * @param thief Worker index of the thief, -1 for a thread outside the pool
+ * @param task Set to the stolen task
+ *
+ * @return boolean: true if a task was stolen
+ */
+bool WorkStealingPool::steal(int thief, Task &task) {
+    int count = (int)deques.size();
+    for (int k = 1; k <= count; k++) {
+        int victim = (thief + k + count) % count;
+        if (victim == thief) continue;
+        WorkerDeque &deque = *deques[victim];
+        std::lock_guard<std::mutex> guard(deque.lock);
+        if (deque.tasks.empty()) continue;
+        task = deque.tasks.front();
+        deque.tasks.pop_front();
+        if (thief >= 0) stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Runs one task if any is queued, worker is -1 for a thread outside the pool
+bool WorkStealingPool::tryRun(int worker) {
+    Task task;
+    if (!(worker >= 0 && popOwn(worker, task)) && !steal(worker, task)) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    task.run(task.context, task.index);
+    // The group may be gone once its count reaches 0, only the pool is touched afterwards
+    if (task.group->count.fetch_sub(1, std::memory_order_release) == 1) {
+        bool waiters;
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            waiters = waiting > 0;
+        }
+        if (waiters) progress.notify_all();
+    }
+    return true;
+}
+
+/** WorkStealingPool::wait
+ * Runs queued tasks, of any group, until every task of group has finished. Tasks spawned by the
+ * tasks of group count towards it too. With nothing left to run while tasks of group are still
+ * running elsewhere, the thread sleeps until a task is queued or the last task of group finishes.
+ *
+ * @param group TaskGroup to wait for
+ */
+void WorkStealingPool::wait(TaskGroup &group) {
+    int worker = currentWorker();
+    while (group.pending() > 0) {
+        if (tryRun(worker)) continue;
+        std::unique_lock<std::mutex> guard(sleepLock);
+        waiting++;
+        progress.wait(guard, [&] { return group.pending() == 0 || queued.load(std::memory_order_acquire) > 0; });
+        waiting--;
+    }
+}
+
+void WorkStealingPool::workerLoop(int worker, bool pinThread) {
+    currentPool = this;
+    ::currentWorker = worker;
+#ifdef __linux__
+    if (pinThread) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(worker % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#else
+    (void)pinThread;
+#endif
+    while (true) {
+        if (tryRun(worker)) continue;
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return !running || queued.load(std::memory_order_acquire) > 0; });
+        if (!running) return;
+    }
+}
@@ -0,0 +1,418 @@
+#include "../include/server.hpp"
+#include "../include/kernels.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Read exactly size bytes, false on error or end of stream
+static bool readFully(int fd, void *buffer, size_t size) {
+    char *at = static_cast<char *>(buffer);
+    while (size > 0) {
+        ssize_t got = read(fd, at, size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        at += got;
+        size -= got;
+    }
+    return true;
+}
+
+// Write exactly size bytes, false on error
+static bool writeFully(int fd, const void *buffer, size_t size) {
+    const char *at = static_cast<const char *>(buffer);
+    while (size > 0) {
+        ssize_t sent = send(fd, at, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        at += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool socketAddress(const std::string &path, sockaddr_un &address) {
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+/** clearStaleSocket
+ * Makes way for binding at a path. Only a socket nobody listens on is removed: a connect() to it
+ * must be refused. A live socket of another server, or any other kind of file, is left alone.
+ *
+ * @param path Path of the socket
+ * @param address Address of the same path
+ *
+ * @return boolean: true if nothing is left at the path
+ */
+static bool clearStaleSocket(const std::string &path, const sockaddr_un &address) {
+    struct stat info;
+    if (lstat(path.c_str(), &info) < 0) return errno == ENOENT;
+    if (!S_ISSOCK(info.st_mode)) return false;
+
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) return false;
+    bool stale = connect(probe, (const sockaddr *)&address, sizeof(address)) < 0 && errno == ECONNREFUSED;
+    ::close(probe);
+    return stale && unlink(path.c_str()) == 0;
+}
+
+/** makeRequestHeader
+ * Fills a request header from the parameters and launch configuration of a decision.
+ *
+ * @param params Parameters_t with NUMPOINTS and all thresholds and separations
+ * @param LCM PackedLCM of the launch configuration
+ * @param PUV Preliminary Unlocking Vector
+ *
+ * @return header to send ahead of the points
+ */
+DecideRequestHeader makeRequestHeader(const Parameters_t &params, const PackedLCM &LCM, std::array<bool, 15> PUV) {
+    DecideRequestHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = DECIDE_MAGIC;
+    header.NUMPOINTS = params.NUMPOINTS;
+    header.LENGTH1 = params.LENGTH1;
+    header.RADIUS1 = params.RADIUS1;
+    header.EPSILON = params.EPSILON;
+    header.AREA1 = params.AREA1;
+    header.DIST = params.DIST;
+    header.LENGTH2 = params.LENGTH2;
+    header.RADIUS2 = params.RADIUS2;
+    header.AREA2 = params.AREA2;
+    header.Q_PTS = params.Q_PTS;
+    header.QUADS = params.QUADS;
+    header.N_PTS = params.N_PTS;
+    header.K_PTS = params.K_PTS;
+    header.A_PTS = params.A_PTS;
+    header.B_PTS = params.B_PTS;
+    header.C_PTS = params.C_PTS;
+    header.D_PTS = params.D_PTS;
+    header.E_PTS = params.E_PTS;
+    header.F_PTS = params.F_PTS;
+    header.G_PTS = params.G_PTS;
+    header.PUV = cmvToMask(PUV);
+    header.LCM = LCM;
+    return header;
+}
+
+/** validParameters
+ * Checks the thresholds and separations of a request before any LIC sees them. Thresholds must be
+ * numbers; the LICs treat negative or out of range ones as not met. Separations must lie between
+ * the smallest value their LIC accepts and maxPoints, so a window never starts before its first
+ * point and no sum of two separations overflows. QUADS must be 1 to 3.
+ *
+ * @param header Request header
+ * @param maxPoints Largest NUMPOINTS the server accepts
+ *
+ * @return boolean: true if the request can be decided
+ */
+static bool validParameters(const DecideRequestHeader &header, int maxPoints) {
+    const double thresholds[] = {header.LENGTH1, header.RADIUS1, header.EPSILON, header.AREA1,
+                                 header.DIST, header.LENGTH2, header.RADIUS2, header.AREA2};
+    for (double threshold : thresholds) {
+        if (std::isnan(threshold)) return false;
+    }
+    const int32_t separations[] = {header.K_PTS, header.A_PTS, header.B_PTS, header.C_PTS,
+                                   header.D_PTS, header.E_PTS, header.F_PTS, header.G_PTS};
+    for (int32_t separation : separations) {
+        if (separation < 1 || separation > maxPoints) return false;
+    }
+    if (header.Q_PTS < 2 || header.Q_PTS > maxPoints || header.N_PTS < 3 || header.N_PTS > maxPoints) return false;
+    return header.QUADS >= 1 && header.QUADS <= 3;
+}
+
+/** decideRequest
+ * Runs the whole decision for one request: CMV with the kernels for its separations, FUV from the
+ * used connectors of its LCM, and the launch decision.
+ *
+ * @param header Request header
+ * @param X X coordinates, header.NUMPOINTS of them
+ * @param Y Y coordinates, header.NUMPOINTS of them
+ *
+ * @return response with status DECIDE_OK
+ */
+DecideResponse decideRequest(const DecideRequestHeader &header, const double *X, const double *Y) {
+    Parameters_t params;
+    params.NUMPOINTS = header.NUMPOINTS;
+    params.X = nullptr;
+    params.Y = nullptr;
+    params.LENGTH1 = header.LENGTH1;
+    params.RADIUS1 = header.RADIUS1;
+    params.EPSILON = header.EPSILON;
+    params.AREA1 = header.AREA1;
+    params.DIST = header.DIST;
+    params.LENGTH2 = header.LENGTH2;
+    params.RADIUS2 = header.RADIUS2;
+    params.AREA2 = header.AREA2;
+    params.Q_PTS = header.Q_PTS;
+    params.QUADS = header.QUADS;
+    params.N_PTS = header.N_PTS;
+    params.K_PTS = header.K_PTS;
+    params.A_PTS = header.A_PTS;
+    params.B_PTS = header.B_PTS;
+    params.C_PTS = header.C_PTS;
+    params.D_PTS = header.D_PTS;
+    params.E_PTS = header.E_PTS;
+    params.F_PTS = header.F_PTS;
+    params.G_PTS = header.G_PTS;
+
+    std::array<bool, 15> PUV;
+    for (int i = 0; i < 15; i++) {
+        PUV[i] = header.PUV >> i & 1;
+    }
+
+    DecidePlan plan = makeDecidePlan(params);
+    std::array<bool, 15> CMV = computeCMV(plan, X, Y, header.NUMPOINTS);
+    std::array<bool, 15> FUV = generateFinalUnlockingVector(CMV, sparseLCM(header.LCM), PUV);
+
+    DecideResponse response;
+    memset(&response, 0, sizeof(response));
+    response.magic = DECIDE_MAGIC;
+    response.status = DECIDE_OK;
+    response.CMV = cmvToMask(CMV);
+    response.FUV = cmvToMask(FUV);
+    response.launch = launchDecision(FUV);
+    return response;
+}
+
+DecideServer::DecideServer(const std::string &path, int workers, int maxPoints)
+    : path(path), workers(workers < 1 ? 1 : workers), maxPoints(maxPoints) {}
+
+DecideServer::~DecideServer() {
+    stop();
+}
+
+/** DecideServer::start
+ * Binds the socket and starts the dispatcher and the workers. A stale socket file at the path, one
+ * no server listens on any more, is replaced; a live socket or any other file makes the start fail.
+ *
+ * @return boolean: false if the path is taken or the socket could not be created, bound or listened on
+ */
+bool DecideServer::start() {
+    sockaddr_un address;
+    if (running || !socketAddress(path, address)) return false;
+
+    if (!clearStaleSocket(path, address)) return false;
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) return false;
+    if (bind(listenFd, (sockaddr *)&address, sizeof(address)) < 0 || listen(listenFd, 64) < 0 ||
+        pipe2(wakeFds, O_NONBLOCK | O_CLOEXEC) < 0) {
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    running = true;
+    dispatcher = std::thread(&DecideServer::dispatchLoop, this);
+    for (int i = 0; i < workers; i++) {
+        threads.emplace_back(&DecideServer::workerLoop, this);
+    }
+    return true;
+}
+
+void DecideServer::stop() {
+    if (!running.exchange(false)) return;
+
+    // Wake the dispatcher in poll(), the workers waiting for requests and those reading one
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (int fd : connections) shutdown(fd, SHUT_RDWR);
+    }
+    requestReady.notify_all();
+    if (write(wakeFds[1], "", 1) < 0) {
+        // The pipe is full, so the dispatcher is awake already
+    }
+    dispatcher.join();
+    for (std::thread &thread : threads) thread.join();
+    threads.clear();
+
+    for (int fd : connections) ::close(fd);
+    connections.clear();
+    ready.clear();
+    returned.clear();
+    ::close(listenFd);
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+    listenFd = wakeFds[0] = wakeFds[1] = -1;
+    unlink(path.c_str());
+}
+
+/** DecideServer::dispatchLoop
+ * Polls the listening socket and every idle connection. New connections join the idle ones, and an
+ * idle connection that becomes readable, with a request or a hangup, is queued for the workers and
+ * left out of the poll until a worker returns it.
+ */
+void DecideServer::dispatchLoop() {
+    std::vector<int> idle;
+    std::vector<pollfd> polled;
+    while (running) {
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            idle.insert(idle.end(), returned.begin(), returned.end());
+            returned.clear();
+        }
+        polled.assign({{wakeFds[0], POLLIN, 0}, {listenFd, POLLIN, 0}});
+        for (int fd : idle) polled.push_back({fd, POLLIN, 0});
+        if (poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        char drained[64];
+        while (read(wakeFds[0], drained, sizeof(drained)) > 0) {
+        }
+        if (polled[1].revents & POLLIN) {
+            int fd;
+            while ((fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC)) >= 0) {
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connections.insert(fd);
+                idle.push_back(fd);
+            }
+        }
+
+        std::vector<int> stillIdle;
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            for (size_t i = 2; i < polled.size(); i++) {
+                if (polled[i].revents != 0) {
+                    ready.push_back(polled[i].fd);
+                    queued = true;
+                } else {
+                    stillIdle.push_back(polled[i].fd);
+                }
+            }
+        }
+        // Connections accepted above were not polled yet
+        stillIdle.insert(stillIdle.end(), idle.begin() + (polled.size() - 2), idle.end());
+        idle.swap(stillIdle);
+        if (queued) requestReady.notify_all();
+    }
+}
+
+void DecideServer::workerLoop() {
+    // Buffers of this worker, reused by every request it answers
+    std::vector<double> X(maxPoints), Y(maxPoints);
+
+    while (true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(connectionsMutex);
+            requestReady.wait(lock, [&] { return !running || !ready.empty(); });
+            if (!running) return;
+            fd = ready.front();
+            ready.pop_front();
+        }
+        if (!serveRequest(fd, X, Y)) {
+            closeConnection(fd);
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            returned.push_back(fd);
+        }
+        if (write(wakeFds[1], "", 1) < 0) {
+            // The pipe is full, so the dispatcher wakes up anyway
+        }
+    }
+}
+
+void DecideServer::closeConnection(int fd) {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connections.erase(fd);
+    ::close(fd);
+}
+
+/** DecideServer::serveRequest
+ * Reads one request from a connection and writes its response.
+ *
+ * @param fd Connection with a request or a hangup waiting
+ * @param X Buffer for the X coordinates, maxPoints of them
+ * @param Y Buffer for the Y coordinates, maxPoints of them
+ *
+ * @return boolean: false if the connection is closed or must be dropped
+ */
+bool DecideServer::serveRequest(int fd, std::vector<double> &X, std::vector<double> &Y) {
+    DecideRequestHeader header;
+    if (!readFully(fd, &header, sizeof(header))) return false;
+    DecideResponse response;
+    memset(&response, 0, sizeof(response));
+    response.magic = DECIDE_MAGIC;
+
+    // The stream cannot be resynchronised after a bad header, so answer and drop the connection
+    if (header.magic != DECIDE_MAGIC) {
+        response.status = DECIDE_BAD_MAGIC;
+        writeFully(fd, &response, sizeof(response));
+        return false;
+    }
+    if (header.NUMPOINTS < 0 || header.NUMPOINTS > maxPoints) {
+        response.status = DECIDE_TOO_MANY_POINTS;
+        writeFully(fd, &response, sizeof(response));
+        return false;
+    }
+
+    size_t bytes = sizeof(double) * header.NUMPOINTS;
+    if (!readFully(fd, X.data(), bytes) || !readFully(fd, Y.data(), bytes)) return false;
+
+    // The points have been read, so the connection stays usable after bad parameters
+    if (validParameters(header, maxPoints)) {
+        response = decideRequest(header, X.data(), Y.data());
+    } else {
+        response.status = DECIDE_BAD_PARAMETERS;
+    }
+    return writeFully(fd, &response, sizeof(response));
+}
+
+/** runServer
+ * Serves decide requests on a Unix domain socket until the process is terminated.
+ *
+ * @param path Path of the socket
+ * @param workers Number of worker threads
+ *
+ * @return 1 if the socket could not be set up
+ */
+int runServer(const std::string &path, int workers) {
+    DecideServer server(path, workers);
+    if (!server.start()) return 1;
+    while (true) pause();
+}
+
+DecideClient::~DecideClient() {
+    close();
+}
+
+bool DecideClient::connect(const std::string &path) {
+    sockaddr_un address;
+    close();
+    if (!socketAddress(path, address)) return false;
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (::connect(fd, (sockaddr *)&address, sizeof(address)) < 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool DecideClient::decide(const DecideRequestHeader &header, const double *X, const double *Y, DecideResponse &response) {
+    if (fd < 0) return false;
+    size_t bytes = sizeof(double) * (header.NUMPOINTS > 0 ? header.NUMPOINTS : 0);
+    if (!writeFully(fd, &header, sizeof(header))) return false;
+    // A server rejecting the header replies and closes without reading the points, so the reply
+    // is read even when sending the points fails
+    if (writeFully(fd, X, bytes)) writeFully(fd, Y, bytes);
+    return readFully(fd, &response, sizeof(response));
+}
+
+void DecideClient::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
@@ -0,0 +1,189 @@
+#include "../include/sharded.hpp"
+#include "../include/context.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Entry of the result table of a shared segment
+typedef struct {
+    BatchDecision decision;
+    int status;
+} ShardResult;
+
+// Where each part of a shared segment starts
+typedef struct {
+    size_t offsets;             // Byte offset of the columns of each point set
+    size_t results;             // ShardResult of each point set
+    size_t columns;
+    size_t bytes;
+} ShardLayout;
+
+static size_t alignUp(size_t bytes) {
+    return (bytes + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT * POOL_ALIGNMENT;
+}
+
+static ShardLayout shardLayout(const PointSetView *items, int count) {
+    ShardLayout layout;
+    layout.offsets = 0;
+    layout.results = alignUp(count * sizeof(size_t));
+    layout.columns = alignUp(layout.results + count * sizeof(ShardResult));
+    layout.bytes = layout.columns;
+    for (int k = 0; k < count; k++) {
+        layout.bytes += 2 * alignUp(items[k].NUMPOINTS * sizeof(double));
+    }
+    return layout;
+}
+
+// Maps a new shared memory segment, unlinked at once so it goes away with the last process using it
+static char *mapSegment(size_t bytes) {
+    static std::atomic<int> segments{0};
+    char name[64];
+    snprintf(name, sizeof(name), "/decide-%d-%d", (int)getpid(), segments.fetch_add(1));
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) return nullptr;
+    shm_unlink(name);
+    void *segment = MAP_FAILED;
+    if (ftruncate(fd, bytes) == 0) {
+        segment = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    return segment == MAP_FAILED ? nullptr : (char *)segment;
+}
+
+// Caps the address space of a worker to what it has now plus shardMemory bytes
+static void limitMemory(size_t shardMemory) {
+#ifdef __linux__
+    if (shardMemory == 0) return;
+    long pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr) return;
+    int read = fscanf(statm, "%ld", &pages);
+    fclose(statm);
+    if (read != 1) return;
+    struct rlimit limit;
+    limit.rlim_cur = limit.rlim_max = pages * sysconf(_SC_PAGESIZE) + shardMemory;
+    setrlimit(RLIMIT_AS, &limit);
+#else
+    (void)shardMemory;
+#endif
+}
+
+/** runShard
+ * Body of worker process `shard`. Each point set is decided in place in the segment and its status
+ * set only once its result is written. A point set that runs out of memory is skipped with a fresh
+ * context, so it fails alone.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param segment Shared segment laid out by layout
+ * @param layout ShardLayout of the segment
+ * @param count Number of point sets
+ * @param numPoints Points of each point set
+ * @param shard Index of this worker
+ * @param shards Number of workers
+ */
+static void runShard(const DecidePlan &plan, char *segment, const ShardLayout &layout, int count, const int *numPoints,
+                     int shard, int shards) {
+    const size_t *offsets = (const size_t *)(segment + layout.offsets);
+    ShardResult *table = (ShardResult *)(segment + layout.results);
+    DecideContext *context = new DecideContext();
+    for (int first = shard * BATCH_RUN; first < count; first += shards * BATCH_RUN) {
+        int last = std::min(first + BATCH_RUN, count);
+        for (int k = first; k < last; k++) {
+            const double *X = (const double *)(segment + offsets[k]);
+            const double *Y = X + alignUp(numPoints[k] * sizeof(double)) / sizeof(double);
+            try {
+                table[k].decision.launch = context->decide(plan, X, Y, numPoints[k]);
+                table[k].decision.CMV = context->CMV();
+                table[k].decision.FUV = context->FUV();
+                table[k].status = SHARD_DECIDED;
+            } catch (const std::bad_alloc &) {
+                delete context;
+                context = new DecideContext();
+            }
+        }
+    }
+}
+
+/** decideSharded
+ * Decides a batch of point sets in `shards` forked worker processes sharing one memory segment
+ * with the coordinator. Nothing is sent through pipes: the workers read the point sets from the
+ * segment and write the result table next to them, and the coordinator reads it back once every
+ * worker has exited. A worker leaves with _exit, so it never runs the destructors of the
+ * coordinator's objects. The segment is zeroed when created, so entries a worker never reached
+ * read as SHARD_FAILED.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param items Point sets
+ * @param count Number of point sets
+ * @param shards Number of worker processes, at least 1
+ * @param results Output, count entries, all false for a failed point set
+ * @param status Output, count entries, may be nullptr
+ * @param shardMemory Memory each worker may add to what it inherits, 0 for no limit
+ *
+ * @return boolean: false if the shared segment could not be created or a worker could not be
+ *         forked, results and status are left unchanged then
+ */
+bool decideSharded(const DecidePlan &plan, const PointSetView *items, int count, int shards, BatchDecision *results,
+                   ShardStatus *status, size_t shardMemory) {
+    if (shards < 1) shards = 1;
+    if (count == 0) return true;
+    ShardLayout layout = shardLayout(items, count);
+    char *segment = mapSegment(layout.bytes);
+    if (segment == nullptr) return false;
+
+    size_t *offsets = (size_t *)(segment + layout.offsets);
+    std::vector<int> numPoints(count);
+    size_t offset = layout.columns;
+    for (int k = 0; k < count; k++) {
+        size_t column = alignUp(items[k].NUMPOINTS * sizeof(double));
+        numPoints[k] = items[k].NUMPOINTS;
+        offsets[k] = offset;
+        if (numPoints[k] > 0) {
+            std::memcpy(segment + offset, items[k].X, numPoints[k] * sizeof(double));
+            std::memcpy(segment + offset + column, items[k].Y, numPoints[k] * sizeof(double));
+        }
+        offset += 2 * column;
+    }
+
+    std::vector<pid_t> workers;
+    bool forked = true;
+    for (int shard = 0; shard < shards && shard * BATCH_RUN < count; shard++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            limitMemory(shardMemory);
+            runShard(plan, segment, layout, count, numPoints.data(), shard, shards);
+            _exit(0);
+        }
+        if (pid < 0) {
+            // The shard would silently read as failed, so the batch fails once started workers are reaped
+            forked = false;
+            break;
+        }
+        workers.push_back(pid);
+    }
+    for (pid_t pid : workers) {
+        while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {
+        }
+    }
+    if (!forked) {
+        munmap(segment, layout.bytes);
+        return false;
+    }
+
+    const ShardResult *table = (const ShardResult *)(segment + layout.results);
+    for (int k = 0; k < count; k++) {
+        bool decided = table[k].status == SHARD_DECIDED;
+        results[k] = decided ? table[k].decision : BatchDecision{};
+        if (status != nullptr) status[k] = decided ? SHARD_DECIDED : SHARD_FAILED;
+    }
+    munmap(segment, layout.bytes);
+    return true;
+}
@@ -0,0 +1,117 @@
+#include "../include/timeline.hpp"
+#include <algorithm>
+#include <utility>
+
+// A latch at prefix `at` is in effect for prefix numPoints
+static bool latched(int at, int numPoints) {
+    return at >= 0 && numPoints >= at;
+}
+
+// Shortest prefix holding window i of a LIC, windows are in order of the prefix they need
+static int windowPrefix(int lic, const Parameters_t &params, int i) {
+    Parameters_t prefix = params;
+    prefix.NUMPOINTS = i + licWindowSpan(lic, params) + 1;
+    while (licWindowCount(lic, prefix) <= i) prefix.NUMPOINTS++;
+    return prefix.NUMPOINTS;
+}
+
+// Finds the first window with each flag bit set, stopping once every required bit is found
+template <int LIC>
+static void latchLic(const Parameters_t &params, DecisionTimeline &timeline) {
+    ArrayPoints pts = {params.X, params.Y};
+    const unsigned required = licRequiredFlags(LIC);
+    int count = licWindowCount(LIC, params);
+    unsigned found = 0;
+    for (int i = 0; i < count && found != required; i++) {
+        unsigned fresh = licWindowFlags<LIC>(params, pts, i) & ~found;
+        if (fresh == 0) continue;
+        int prefix = windowPrefix(LIC, params, i);
+        if (fresh & 1) timeline.flagLatch[0][LIC] = prefix;
+        if (fresh & 2) timeline.flagLatch[1][LIC] = prefix;
+        found |= fresh;
+    }
+}
+
+template <int... LIC>
+static void latchAll(const Parameters_t &params, DecisionTimeline &timeline, std::integer_sequence<int, LIC...>) {
+    (latchLic<LIC>(params, timeline), ...);
+}
+
+/** decisionTimeline
+ * Records the decision of every prefix of a recording in one pass. Each LIC scans its windows in
+ * order until its required flags are set, the window holding a flag first gives the prefix where
+ * it latches. The FUV and launch decision only change where a CMV entry latches, so they are
+ * evaluated at those at most 15 prefixes with the launch configuration of the plan.
+ *
+ * @param plan DecidePlan with the parameters and launch configuration
+ * @param X X coordinates of the recording
+ * @param Y Y coordinates of the recording
+ * @param numPoints Number of points of the recording
+ *
+ * @return DecisionTimeline with the latch prefixes and the events in prefix order
+ */
+DecisionTimeline decisionTimeline(const DecidePlan &plan, const double *X, const double *Y, int numPoints) {
+    Parameters_t params = plan.params;
+    params.NUMPOINTS = numPoints;
+    params.X = const_cast<double *>(X);
+    params.Y = const_cast<double *>(Y);
+
+    DecisionTimeline timeline;
+    timeline.flagLatch[0].fill(-1);
+    timeline.flagLatch[1].fill(-1);
+    latchAll(params, timeline, std::make_integer_sequence<int, 15>());
+
+    for (int lic = 0; lic < 15; lic++) {
+        int latch = timeline.flagLatch[0][lic];
+        if (licRequiredFlags(lic) & 2) {
+            int second = timeline.flagLatch[1][lic];
+            latch = latch < 0 || second < 0 ? -1 : std::max(latch, second);
+        }
+        timeline.cmvLatch[lic] = latch;
+        if (latch >= 0) timeline.events.push_back({latch, TIMELINE_CMV, lic});
+    }
+    std::stable_sort(timeline.events.begin(), timeline.events.end(),
+                     [](const TimelineEvent &a, const TimelineEvent &b) { return a.points < b.points; });
+
+    // The empty prefix, then every prefix where the CMV changes
+    std::vector<int> prefixes = {0};
+    for (const TimelineEvent &event : timeline.events) {
+        if (event.points != prefixes.back()) prefixes.push_back(event.points);
+    }
+
+    timeline.fuvLatch.fill(-1);
+    timeline.launchLatch = -1;
+    std::vector<TimelineEvent> changes;
+    for (int prefix : prefixes) {
+        std::array<bool, 15> fuv = generateFinalUnlockingVector(timelineCMV(timeline, prefix), plan.LCM, plan.PUV);
+        for (int i = 0; i < 15; i++) {
+            if (fuv[i] && timeline.fuvLatch[i] < 0) {
+                timeline.fuvLatch[i] = prefix;
+                changes.push_back({prefix, TIMELINE_FUV, i});
+            }
+        }
+        if (launchDecision(fuv) && timeline.launchLatch < 0) {
+            timeline.launchLatch = prefix;
+            changes.push_back({prefix, TIMELINE_LAUNCH, 0});
+        }
+    }
+
+    // CMV events of a prefix come before the FUV and launch events they cause
+    std::vector<TimelineEvent> merged;
+    std::merge(timeline.events.begin(), timeline.events.end(), changes.begin(), changes.end(), std::back_inserter(merged),
+               [](const TimelineEvent &a, const TimelineEvent &b) { return a.points < b.points; });
+    timeline.events = std::move(merged);
+    return timeline;
+}
+
+std::array<bool, 15> timelineCMV(const DecisionTimeline &timeline, int numPoints) {
+    std::array<bool, 15> cmv;
+    for (int lic = 0; lic < 15; lic++) {
+        cmv[lic] = latched(timeline.cmvLatch[lic], numPoints);
+    }
+    return cmv;
+}
+
+bool timelineLaunch(const DecisionTimeline &timeline, int numPoints) {
+    return latched(timeline.launchLatch, numPoints);
+}
@@ -2,6 +2,90 @@
 
 #include "../external/catch.hpp"
 #include "../include/decide.hpp"
+#include "../include/multitrack.hpp"
+#include "../include/kernels.hpp"
+#include "../include/lcm.hpp"
+#include "../include/server.hpp"
+#include "../include/decide_c.h"
+#include "../include/context.hpp"
+#include "../include/conditions.hpp"
+#include "../include/dispatch.hpp"
+#include "../include/pool.hpp"
+#include "../include/exact.hpp"
+#include "../include/features.hpp"
+#include "../include/range.hpp"
+#include "../include/realtime.hpp"
+#include "../include/timeline.hpp"
+#include "../include/boxes.hpp"
+#include "../include/chunked.hpp"
+#include "../include/parallel.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/sharded.hpp"
+#include "../include/robust.hpp"
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Test hook: every global operator new of the test binary is counted, so tests can check that a
+// code path does not allocate. The whole family is replaced, so every block comes from malloc or
+// aligned_alloc and goes back through free.
+static std::atomic<long> heapAllocations{0};
+
+static void *countedAllocation(std::size_t size, std::size_t alignment) {
+    heapAllocations++;
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static void countedRelease(void *block) noexcept {
+    std::free(block);
+}
+
+static void *throwingAllocation(std::size_t size, std::size_t alignment) {
+    void *block = countedAllocation(size, alignment);
+    if (block == nullptr) throw std::bad_alloc();
+    return block;
+}
+
+static const std::size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+void *operator new(std::size_t size) { return throwingAllocation(size, DEFAULT_ALIGNMENT); }
+void *operator new[](std::size_t size) { return throwingAllocation(size, DEFAULT_ALIGNMENT); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAllocation(size, DEFAULT_ALIGNMENT); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAllocation(size, DEFAULT_ALIGNMENT); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return throwingAllocation(size, (std::size_t)alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return throwingAllocation(size, (std::size_t)alignment); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return countedAllocation(size, (std::size_t)alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return countedAllocation(size, (std::size_t)alignment);
+}
+
+void operator delete(void *block) noexcept { countedRelease(block); }
+void operator delete[](void *block) noexcept { countedRelease(block); }
+void operator delete(void *block, std::size_t) noexcept { countedRelease(block); }
+void operator delete[](void *block, std::size_t) noexcept { countedRelease(block); }
+void operator delete(void *block, const std::nothrow_t &) noexcept { countedRelease(block); }
+void operator delete[](void *block, const std::nothrow_t &) noexcept { countedRelease(block); }
+void operator delete(void *block, std::align_val_t) noexcept { countedRelease(block); }
+void operator delete[](void *block, std::align_val_t) noexcept { countedRelease(block); }
+void operator delete(void *block, std::size_t, std::align_val_t) noexcept { countedRelease(block); }
+void operator delete[](void *block, std::size_t, std::align_val_t) noexcept { countedRelease(block); }
+void operator delete(void *block, std::align_val_t, const std::nothrow_t &) noexcept { countedRelease(block); }
+void operator delete[](void *block, std::align_val_t, const std::nothrow_t &) noexcept { countedRelease(block); }
 
 // Tests for doubleCompare
 
@@ -1230,3 +1314,2636 @@ TEST_CASE("FUV is mixed", "[launchDecision]") {
 
     REQUIRE(launchDecision(testFUV) == false);
 }
+
+
+// Tests for computeCMV
+
+TEST_CASE("CMV matches the individual LICs", "[computeCMV]") {
+    Parameters_t params;
+    params.LENGTH1 = 1.0;
+    params.RADIUS1 = 3.0;
+    params.RADIUS2 = 9.0;
+    params.EPSILON = 0.2;
+    params.DIST = 5.0;
+    params.A_PTS = 1;
+    params.B_PTS = 1;
+    params.C_PTS = 1;
+    params.D_PTS = 1;
+    params.G_PTS = 1;
+    params.QUADS = 1;
+    params.Q_PTS = 4;
+    params.K_PTS = 1;
+    params.N_PTS = 3;
+    params.E_PTS = 2;
+    params.F_PTS = 2;
+    params.NUMPOINTS = 8;
+    params.AREA1 = 20;
+    params.AREA2 = 12;
+    params.LENGTH2 = 3;
+    params.X = new double[8]{-100, 0, 2, 0, 1, 12, -50, 2};
+    params.Y = new double[8]{0, -1, 3, 100, 0, 32, 50, -2};
+
+    std::array<bool, 15> CMV = computeCMV(params);
+    REQUIRE(CMV[0] == isConsecDistGTLen(params));
+    REQUIRE(CMV[6] == isDistFromLine(params));
+    REQUIRE(CMV[8] == sepPointsContainedInCircle(params));
+    REQUIRE(CMV[9] == isAngleWithinThreshold(params));
+    REQUIRE(CMV[12] == lic12(params));
+    REQUIRE(CMV[14] == lic14(params));
+    REQUIRE(cmvToMask(CMV) >> 15 == 0);
+    for (int i = 0; i < 15; i++) {
+        REQUIRE((cmvToMask(CMV) >> i & 1) == CMV[i]);
+    }
+}
+
+// Random small-integer points and parameters that reach both outcomes of every LIC
+static Parameters_t randomParameters(std::mt19937 &gen, int numPoints, double *X, double *Y) {
+    auto pick = [&](int lo, int hi) { return lo + (int)(gen() % (hi - lo + 1)); };
+    for (int i = 0; i < numPoints; i++) {
+        X[i] = pick(-10, 10);
+        Y[i] = pick(-10, 10);
+    }
+    Parameters_t params;
+    params.NUMPOINTS = numPoints;
+    params.X = X;
+    params.Y = Y;
+    params.LENGTH1 = pick(-1, 15);
+    params.RADIUS1 = pick(0, 10) * 0.7;
+    params.EPSILON = pick(0, 4) * 0.8;
+    params.AREA1 = pick(-1, 60);
+    params.Q_PTS = pick(2, 6);
+    params.QUADS = pick(1, 3);
+    params.DIST = pick(0, 10);
+    params.N_PTS = pick(3, 6);
+    params.K_PTS = pick(1, 4);
+    params.A_PTS = pick(1, 3);
+    params.B_PTS = pick(1, 3);
+    params.C_PTS = pick(1, 3);
+    params.D_PTS = pick(1, 3);
+    params.E_PTS = pick(1, 3);
+    params.F_PTS = pick(1, 3);
+    params.G_PTS = pick(1, 4);
+    params.LENGTH2 = pick(-1, 15);
+    params.RADIUS2 = pick(0, 10) * 0.7;
+    params.AREA2 = pick(1, 60);
+    return params;
+}
+
+// Tests for MultiTrackSet
+
+TEST_CASE("tracks of different lengths match the scalar CMV", "[MultiTrackSet]") {
+    std::mt19937 gen(26);
+    for (int round = 0; round < 200; round++) {
+        std::vector<std::vector<double>> X(21), Y(21);
+        Parameters_t params;
+        MultiTrackSet tracks;
+        for (int t = 0; t < 21; t++) {
+            int numPoints = gen() % 16;
+            X[t].resize(numPoints + 1);
+            Y[t].resize(numPoints + 1);
+            params = randomParameters(gen, numPoints, X[t].data(), Y[t].data());
+        }
+        // All tracks share the parameters drawn last
+        for (int t = 0; t < 21; t++) {
+            REQUIRE(tracks.addTrack(X[t].data(), Y[t].data(), (int)X[t].size() - 1) == t);
+        }
+        REQUIRE(tracks.size() == 21);
+
+        std::vector<uint16_t> masks = tracks.evaluate(params);
+        REQUIRE(masks.size() == 21);
+        for (int t = 0; t < 21; t++) {
+            params.NUMPOINTS = (int)X[t].size() - 1;
+            params.X = X[t].data();
+            params.Y = Y[t].data();
+            REQUIRE(masks[t] == cmvToMask(computeCMV(params)));
+        }
+    }
+}
+
+TEST_CASE("empty track set", "[MultiTrackSet]") {
+    Parameters_t params;
+    MultiTrackSet tracks;
+    REQUIRE(tracks.evaluate(params).empty());
+
+    double X[2] = {0, 5};
+    double Y[2] = {0, 0};
+    tracks.addTrack(X, Y, 2);
+    tracks.clear();
+    REQUIRE(tracks.size() == 0);
+}
+
+// Tests for the fixed separation kernels
+
+TEST_CASE("common separations have specialised kernels", "[selectLicKernel]") {
+    Parameters_t params;
+    params.Q_PTS = 3;
+    params.N_PTS = 3;
+    params.K_PTS = 2;
+    params.A_PTS = 1;
+    params.B_PTS = 4;
+    params.C_PTS = 2;
+    params.D_PTS = 2;
+    params.E_PTS = 3;
+    params.F_PTS = 1;
+    params.G_PTS = 4;
+    for (int i = 0; i < 15; i++) {
+        REQUIRE(hasFixedLicKernel(i, params));
+    }
+
+    params.K_PTS = 40;
+    params.B_PTS = 5;
+    REQUIRE(hasFixedLicKernel(7, params) == false);
+    REQUIRE(hasFixedLicKernel(12, params) == false);
+    REQUIRE(hasFixedLicKernel(8, params) == false);
+    REQUIRE(hasFixedLicKernel(13, params) == false);
+    REQUIRE(hasFixedLicKernel(9, params));
+}
+
+TEST_CASE("plan kernels match the runtime LICs", "[DecidePlan]") {
+    std::mt19937 gen(27);
+    double X[64], Y[64];
+    for (int round = 0; round < 3000; round++) {
+        int numPoints = gen() % 60;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        // Step outside the dispatch table now and then
+        if (round % 5 == 0) params.K_PTS += 4;
+        if (round % 7 == 0) params.B_PTS += 4;
+
+        DecidePlan plan = makeDecidePlan(params);
+        REQUIRE(computeCMV(plan, X, Y, numPoints) == computeCMV(params));
+    }
+}
+
+// Tests for the folded launch configuration
+
+static constexpr LaunchConfig TEST_MISSION = [] {
+    LaunchConfig config = unusedLaunchConfig();
+    connectLics(config, 0, 1, ANDD);
+    connectLics(config, 0, 2, ORR);
+    connectLics(config, 3, 4, ORR);
+    connectLics(config, 4, 5, ORR);
+    connectLics(config, 2, 9, ANDD);
+    config.PUV[0] = true;
+    config.PUV[4] = true;
+    config.PUV[9] = true;
+    return config;
+}();
+
+static_assert(isSymmetricLCM(TEST_MISSION), "test mission is symmetric");
+static_assert(hasValidConnectors(TEST_MISSION), "test mission has a NOTUSED diagonal");
+static_assert(foldLaunchConfig(TEST_MISSION).required == ((1 << 0) | (1 << 1) | (1 << 2) | (1 << 9)), "ANDD rows fold into required");
+static_assert(foldLaunchConfig(TEST_MISSION).eitherOf[0] == 0, "row 0 is covered by required");
+static_assert(foldLaunchConfig(TEST_MISSION).eitherOf[4] == ((1 << 3) | (1 << 5)), "ORR row 4 stays");
+
+// Launch decision through the PUM/FUV stages
+static bool launchThroughPUM(uint16_t cmv, const std::array<std::array<Connectors, 15>, 15> &LCM, const std::array<bool, 15> &PUV) {
+    std::array<bool, 15> CMV;
+    for (int i = 0; i < 15; i++) CMV[i] = cmv >> i & 1;
+    return launchDecision(generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV));
+}
+
+TEST_CASE("compile-time folded mission matches PUM/FUV for every CMV", "[launchFor]") {
+    std::array<std::array<Connectors, 15>, 15> LCM;
+    std::array<bool, 15> PUV;
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) LCM[i][j] = TEST_MISSION.LCM[i][j];
+        PUV[i] = TEST_MISSION.PUV[i];
+    }
+    for (int cmv = 0; cmv < (1 << 15); cmv++) {
+        REQUIRE(launchFor<TEST_MISSION>(cmv) == launchThroughPUM(cmv, LCM, PUV));
+    }
+}
+
+TEST_CASE("runtime folding of random configurations", "[foldLaunchConfig]") {
+    std::mt19937 gen(28);
+    for (int round = 0; round < 200; round++) {
+        std::array<std::array<Connectors, 15>, 15> LCM;
+        std::array<bool, 15> PUV;
+        const Connectors ops[3] = {NOTUSED, ORR, ANDD};
+        // Mostly NOTUSED, like real missions
+        for (int i = 0; i < 15; i++) {
+            LCM[i][i] = NOTUSED;
+            for (int j = i + 1; j < 15; j++) {
+                LCM[i][j] = LCM[j][i] = gen() % 4 == 0 ? ops[1 + gen() % 2] : ops[0];
+            }
+            PUV[i] = gen() % 2;
+        }
+        LaunchConfig config = toLaunchConfig(LCM, PUV);
+        REQUIRE(isSymmetricLCM(config));
+        REQUIRE(hasValidConnectors(config));
+        FoldedLaunch folded = foldLaunchConfig(config);
+        for (int k = 0; k < 200; k++) {
+            uint16_t cmv = gen() & 0x7fff;
+            // Skew towards mostly met conditions so both outcomes occur
+            if (k % 2) cmv |= gen() & 0x7fff;
+            REQUIRE(foldedLaunchDecision(folded, cmv) == launchThroughPUM(cmv, LCM, PUV));
+        }
+    }
+}
+
+TEST_CASE("asymmetric and used diagonal are rejected", "[hasValidConnectors]") {
+    LaunchConfig config = unusedLaunchConfig();
+    config.LCM[2][3] = ORR;
+    REQUIRE(isSymmetricLCM(config) == false);
+    config.LCM[3][2] = ORR;
+    REQUIRE(isSymmetricLCM(config));
+    config.LCM[5][5] = ANDD;
+    REQUIRE(hasValidConnectors(config) == false);
+}
+
+// Tests for the packed and sparse LCM
+
+static std::array<std::array<Connectors, 15>, 15> randomSymmetricLCM(std::mt19937 &gen, int usedOneIn) {
+    std::array<std::array<Connectors, 15>, 15> LCM;
+    for (int i = 0; i < 15; i++) {
+        LCM[i][i] = NOTUSED;
+        for (int j = i + 1; j < 15; j++) {
+            LCM[i][j] = LCM[j][i] = gen() % usedOneIn ? NOTUSED : (gen() % 2 ? ORR : ANDD);
+        }
+    }
+    return LCM;
+}
+
+TEST_CASE("packed LCM round trip", "[packLCM]") {
+    std::mt19937 gen(29);
+    REQUIRE(sizeof(PackedLCM) == 32);
+    for (int round = 0; round < 100; round++) {
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 4);
+        PackedLCM packed = packLCM(LCM);
+        REQUIRE(unpackLCM(packed) == LCM);
+        REQUIRE(packedConnector(packed, 3, 9) == LCM[9][3]);
+    }
+}
+
+TEST_CASE("sparse LCM lists only used connectors", "[sparseLCM]") {
+    std::array<std::array<Connectors, 15>, 15> LCM;
+    for (int i = 0; i < 15; i++) LCM[i].fill(NOTUSED);
+    LCM[2][14] = LCM[14][2] = ANDD;
+    LCM[0][1] = LCM[1][0] = ORR;
+
+    SparseLCM sparse = sparseLCM(packLCM(LCM));
+    REQUIRE(sparse.count == 2);
+    REQUIRE(sparse.entries[0].i == 0);
+    REQUIRE(sparse.entries[0].j == 1);
+    REQUIRE(sparse.entries[0].op == 1);
+    REQUIRE(sparse.entries[1].i == 2);
+    REQUIRE(sparse.entries[1].j == 14);
+    REQUIRE(sparse.entries[1].op == 2);
+}
+
+TEST_CASE("sparse PUM and FUV match the dense stages", "[generateFinalUnlockingVector]") {
+    std::mt19937 gen(290);
+    for (int round = 0; round < 500; round++) {
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 8);
+        SparseLCM sparse = sparseLCM(packLCM(LCM));
+        std::array<bool, 15> CMV, PUV;
+        for (int i = 0; i < 15; i++) {
+            CMV[i] = gen() % 3 != 0;
+            PUV[i] = gen() % 2;
+        }
+        std::array<std::array<bool, 15>, 15> PUM = generatePreliminaryUnlockingMatrix(CMV, LCM);
+        REQUIRE(generatePreliminaryUnlockingMatrix(CMV, sparse) == PUM);
+        REQUIRE(generateFinalUnlockingVector(CMV, sparse, PUV) == generateFinalUnlockingVector(PUM, PUV));
+    }
+}
+
+// Tests for ConfigBatch
+
+TEST_CASE("bit-sliced configurations match the dense pipeline", "[ConfigBatch]") {
+    std::mt19937 gen(30);
+    std::vector<std::array<std::array<Connectors, 15>, 15>> LCMs;
+    std::vector<std::array<bool, 15>> PUVs;
+    ConfigBatch batch;
+    for (int c = 0; c < 150; c++) {
+        LCMs.push_back(randomSymmetricLCM(gen, 2 + c % 12));
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 3 == 0;
+        PUVs.push_back(PUV);
+        REQUIRE(batch.add(packLCM(LCMs.back()), PUV) == c);
+    }
+    REQUIRE(batch.size() == 150);
+
+    int launches = 0;
+    for (int round = 0; round < 300; round++) {
+        uint16_t cmv = (gen() | gen()) & 0x7fff;
+        std::vector<uint64_t> decisions = batch.launchDecisions(cmv);
+        REQUIRE(decisions.size() == 3);
+        REQUIRE(decisions[2] >> 22 == 0);
+        for (int c = 0; c < 150; c++) {
+            bool launch = decisions[c / 64] >> (c % 64) & 1;
+            REQUIRE(launch == launchThroughPUM(cmv, LCMs[c], PUVs[c]));
+            launches += launch;
+        }
+    }
+    REQUIRE(launches > 0);
+}
+
+// Tests for the decide server
+
+TEST_CASE("licWindowCount rejects separations that leave the window or overflow", "[licWindowCount]") {
+    std::mt19937 gen(311);
+    double X[10], Y[10];
+    Parameters_t params = randomParameters(gen, 10, X, Y);
+    params.AREA1 = params.AREA2 = 1;
+    params.E_PTS = params.F_PTS = 1;
+    REQUIRE(licWindowCount(14, params) == 6);
+    params.E_PTS = -40;
+    REQUIRE(licWindowCount(14, params) == 0);
+    REQUIRE_FALSE(evaluateLic(14, params));
+    params.E_PTS = 1;
+    params.F_PTS = -2;
+    REQUIRE(licWindowCount(14, params) == 0);
+    params.F_PTS = 0;
+    REQUIRE(licWindowCount(14, params) == 7);
+
+    params.E_PTS = params.F_PTS = INT32_MAX;
+    REQUIRE(licWindowCount(10, params) == 0);
+    REQUIRE(licWindowCount(14, params) == 0);
+    params.A_PTS = params.B_PTS = params.C_PTS = params.D_PTS = INT32_MAX;
+    REQUIRE(licWindowCount(8, params) == 0);
+    REQUIRE(licWindowCount(9, params) == 0);
+    REQUIRE(licWindowCount(13, params) == 0);
+}
+
+// LIC 14 as the original lic14 wrote it, without the window checks of licWindowCount
+static bool baselineLic14(const Parameters_t &params) {
+    if (params.NUMPOINTS < 5 || params.AREA1 <= 0 || params.AREA2 <= 0) return false;
+    bool a1 = false, a2 = false;
+    for (int i = 0; i < params.NUMPOINTS - params.E_PTS - params.F_PTS - 2; i++) {
+        int second = i + params.E_PTS + 1;
+        int third = second + params.F_PTS + 1;
+        double area = 0.5 * std::abs(params.X[i] * (params.Y[second] - params.Y[third]) +
+                                     params.X[second] * (params.Y[third] - params.Y[i]) +
+                                     params.X[third] * (params.Y[i]) - params.Y[second]);
+        if (doubleCompare(area, params.AREA1) == GT) a1 = true;
+        if (doubleCompare(area, params.AREA2) == LT) a2 = true;
+    }
+    return a1 && a2;
+}
+
+TEST_CASE("LIC 14 keeps the original results for separations of 0 and -1", "[licWindowCount]") {
+    std::mt19937 gen(313);
+    std::vector<double> X(64), Y(64);
+    DecideContext context;
+    for (int round = 0; round < 400; round++) {
+        int numPoints = 5 + gen() % 60;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        params.AREA1 = 1 + gen() % 40;
+        params.AREA2 = 1 + gen() % 40;
+        params.E_PTS = (int)(gen() % 4) - 1;
+        params.F_PTS = (int)(gen() % 4) - 1;
+
+        // Every window of these separations lies inside the points, as in the original lic14
+        bool expected = baselineLic14(params);
+        REQUIRE(licWindowCount(14, params) == std::max(numPoints - params.E_PTS - params.F_PTS - 2, 0));
+        REQUIRE(evaluateLic(14, params) == expected);
+        REQUIRE(computeCMV(makeDecidePlan(params), X.data(), Y.data(), numPoints)[14] == expected);
+        context.decide(makeDecidePlan(params), X.data(), Y.data(), numPoints);
+        REQUIRE(context.CMV()[14] == expected);
+    }
+
+    // Below -1 the original read before the first point, now there are no windows
+    Parameters_t params = randomParameters(gen, 20, X.data(), Y.data());
+    params.E_PTS = -2;
+    REQUIRE(licWindowCount(14, params) == 0);
+    REQUIRE_FALSE(evaluateLic(14, params));
+}
+
+TEST_CASE("server answers like the local pipeline", "[DecideServer]") {
+    std::string path = "/tmp/decide-test-" + std::to_string(getpid()) + ".sock";
+    DecideServer server(path, 2, 256);
+    REQUIRE(server.start());
+
+    std::mt19937 gen(31);
+    DecideClient first, second;
+    REQUIRE(first.connect(path));
+    REQUIRE(second.connect(path));
+    double X[64], Y[64];
+    for (int round = 0; round < 100; round++) {
+        int numPoints = gen() % 60;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 3);
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 3 == 0;
+
+        DecideResponse response;
+        DecideClient &client = round % 2 ? first : second;
+        REQUIRE(client.decide(makeRequestHeader(params, packLCM(LCM), PUV), X, Y, response));
+        REQUIRE(response.magic == DECIDE_MAGIC);
+        REQUIRE(response.status == DECIDE_OK);
+
+        std::array<bool, 15> CMV = computeCMV(params);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+        REQUIRE(response.CMV == cmvToMask(CMV));
+        REQUIRE(response.FUV == cmvToMask(FUV));
+        REQUIRE(response.launch == launchDecision(FUV));
+    }
+    server.stop();
+}
+
+TEST_CASE("server rejects bad requests", "[DecideServer]") {
+    std::string path = "/tmp/decide-test-" + std::to_string(getpid()) + "-bad.sock";
+    DecideServer server(path, 1, 16);
+    REQUIRE(server.start());
+
+    std::mt19937 gen(310);
+    double X[32] = {0}, Y[32] = {0};
+    Parameters_t params = {};
+    params.NUMPOINTS = 32;
+    std::array<bool, 15> PUV = {false};
+    DecideRequestHeader header = makeRequestHeader(params, PackedLCM(), PUV);
+
+    DecideClient client;
+    DecideResponse response;
+    REQUIRE(client.connect(path));
+    REQUIRE(client.decide(header, X, Y, response));
+    REQUIRE(response.status == DECIDE_TOO_MANY_POINTS);
+
+    header.NUMPOINTS = 2;
+    header.magic = 0;
+    REQUIRE(client.connect(path));
+    REQUIRE(client.decide(header, X, Y, response));
+    REQUIRE(response.status == DECIDE_BAD_MAGIC);
+
+    // Separations that would read before the points, or overflow when added, are refused
+    Parameters_t valid = randomParameters(gen, 10, X, Y);
+    valid.AREA1 = valid.AREA2 = 1;
+    header = makeRequestHeader(valid, PackedLCM(), PUV);
+    REQUIRE(client.connect(path));
+    REQUIRE(client.decide(header, X, Y, response));
+    REQUIRE(response.status == DECIDE_OK);
+    DecideRequestHeader bad = header;
+    bad.E_PTS = -40;
+    REQUIRE(client.decide(bad, X, Y, response));
+    REQUIRE(response.status == DECIDE_BAD_PARAMETERS);
+    bad = header;
+    bad.A_PTS = bad.B_PTS = INT32_MAX;
+    REQUIRE(client.decide(bad, X, Y, response));
+    REQUIRE(response.status == DECIDE_BAD_PARAMETERS);
+    bad = header;
+    bad.AREA2 = NAN;
+    REQUIRE(client.decide(bad, X, Y, response));
+    REQUIRE(response.status == DECIDE_BAD_PARAMETERS);
+    bad = header;
+    bad.QUADS = 0;
+    REQUIRE(client.decide(bad, X, Y, response));
+    REQUIRE(response.status == DECIDE_BAD_PARAMETERS);
+    // The connection stays usable after bad parameters
+    REQUIRE(client.decide(header, X, Y, response));
+    REQUIRE(response.status == DECIDE_OK);
+
+    // Stopping with a client still connected must not hang
+    REQUIRE(client.connect(path));
+    server.stop();
+}
+
+TEST_CASE("idle clients do not hold the server workers", "[DecideServer]") {
+    std::string path = "/tmp/decide-test-" + std::to_string(getpid()) + "-idle.sock";
+    DecideServer server(path, 2, 64);
+    REQUIRE(server.start());
+
+    std::mt19937 gen(312);
+    double X[64], Y[64];
+    std::array<bool, 15> PUV = {false};
+    auto answers = [&](DecideClient &client) {
+        Parameters_t params = randomParameters(gen, 40, X, Y);
+        DecideResponse response;
+        return client.decide(makeRequestHeader(params, PackedLCM(), PUV), X, Y, response) &&
+               response.status == DECIDE_OK && response.CMV == cmvToMask(computeCMV(params));
+    };
+
+    // Every client sends one request and then keeps its connection open without sending more
+    std::vector<DecideClient> clients(8);
+    for (DecideClient &client : clients) {
+        REQUIRE(client.connect(path));
+        REQUIRE(answers(client));
+    }
+    DecideClient late;
+    REQUIRE(late.connect(path));
+    REQUIRE(answers(late));
+    for (DecideClient &client : clients) REQUIRE(answers(client));
+
+    // A client closing its connection frees it on the server side
+    clients[0].close();
+    REQUIRE(answers(late));
+    server.stop();
+}
+
+TEST_CASE("server only replaces a stale socket", "[DecideServer]") {
+    std::string path = "/tmp/decide-test-" + std::to_string(getpid()) + "-taken.sock";
+    DecideServer first(path, 1, 16), second(path, 1, 16);
+    REQUIRE(first.start());
+    REQUIRE_FALSE(second.start());
+
+    // The first server still answers
+    double X[4] = {0, 1, 2, 3}, Y[4] = {0, 1, 0, 1};
+    Parameters_t params = {};
+    params.NUMPOINTS = 4;
+    params.Q_PTS = 2;
+    params.QUADS = params.N_PTS = 3;
+    params.K_PTS = params.A_PTS = params.B_PTS = params.C_PTS = params.D_PTS = 1;
+    params.E_PTS = params.F_PTS = params.G_PTS = 1;
+    std::array<bool, 15> PUV = {false};
+    DecideClient client;
+    DecideResponse response;
+    REQUIRE(client.connect(path));
+    REQUIRE(client.decide(makeRequestHeader(params, PackedLCM(), PUV), X, Y, response));
+    REQUIRE(response.status == DECIDE_OK);
+    client.close();
+    first.stop();
+
+    // A socket nobody listens on is replaced
+    int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path.c_str());
+    REQUIRE(bind(stale, (sockaddr *)&address, sizeof(address)) == 0);
+    close(stale);
+    REQUIRE(second.start());
+    second.stop();
+
+    // Any other file is left alone
+    FILE *file = fopen(path.c_str(), "w");
+    fputs("data", file);
+    fclose(file);
+    DecideServer third(path, 1, 16);
+    REQUIRE_FALSE(third.start());
+    struct stat info;
+    REQUIRE(stat(path.c_str(), &info) == 0);
+    REQUIRE(info.st_size == 4);
+    unlink(path.c_str());
+}
+
+// Tests for the C interface
+
+static decide_params toDecideParams(const Parameters_t &params) {
+    decide_params p;
+    p.LENGTH1 = params.LENGTH1;
+    p.RADIUS1 = params.RADIUS1;
+    p.EPSILON = params.EPSILON;
+    p.AREA1 = params.AREA1;
+    p.DIST = params.DIST;
+    p.LENGTH2 = params.LENGTH2;
+    p.RADIUS2 = params.RADIUS2;
+    p.AREA2 = params.AREA2;
+    p.Q_PTS = params.Q_PTS;
+    p.QUADS = params.QUADS;
+    p.N_PTS = params.N_PTS;
+    p.K_PTS = params.K_PTS;
+    p.A_PTS = params.A_PTS;
+    p.B_PTS = params.B_PTS;
+    p.C_PTS = params.C_PTS;
+    p.D_PTS = params.D_PTS;
+    p.E_PTS = params.E_PTS;
+    p.F_PTS = params.F_PTS;
+    p.G_PTS = params.G_PTS;
+    return p;
+}
+
+TEST_CASE("C interface single and batch decisions", "[decide_c]") {
+    REQUIRE(decide_abi_version() == DECIDE_ABI_VERSION);
+
+    std::mt19937 gen(32);
+    for (int round = 0; round < 50; round++) {
+        std::vector<std::vector<double>> X(8, std::vector<double>(64)), Y(8, std::vector<double>(64));
+        std::vector<int> sizes(8);
+        Parameters_t params;
+        for (int k = 0; k < 8; k++) {
+            sizes[k] = gen() % 60;
+            params = randomParameters(gen, sizes[k], X[k].data(), Y[k].data());
+        }
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 3);
+        uint8_t lcm[225];
+        for (int i = 0; i < 225; i++) {
+            Connectors op = LCM[i / 15][i % 15];
+            lcm[i] = op == ORR ? DECIDE_ORR : op == ANDD ? DECIDE_ANDD : DECIDE_NOTUSED;
+        }
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 3 == 0;
+
+        decide_params p = toDecideParams(params);
+        decide_plan *plan = nullptr;
+        decide_session *session = nullptr;
+        REQUIRE(decide_plan_create(&p, lcm, cmvToMask(PUV), &plan) == DECIDE_SUCCESS);
+        REQUIRE(decide_session_create(plan, &session) == DECIDE_SUCCESS);
+
+        decide_points items[8];
+        decide_result results[8];
+        for (int k = 0; k < 8; k++) {
+            items[k] = {X[k].data(), Y[k].data(), sizes[k]};
+        }
+        REQUIRE(decide_run_batch(session, items, 8, results) == DECIDE_SUCCESS);
+
+        for (int k = 0; k < 8; k++) {
+            params.NUMPOINTS = sizes[k];
+            params.X = X[k].data();
+            params.Y = Y[k].data();
+            std::array<bool, 15> CMV = computeCMV(params);
+            std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+
+            decide_result single;
+            REQUIRE(decide_run(session, X[k].data(), Y[k].data(), sizes[k], &single) == DECIDE_SUCCESS);
+            REQUIRE(single.cmv == cmvToMask(CMV));
+            REQUIRE(single.fuv == cmvToMask(FUV));
+            REQUIRE(single.launch == launchDecision(FUV));
+            REQUIRE(results[k].cmv == single.cmv);
+            REQUIRE(results[k].fuv == single.fuv);
+            REQUIRE(results[k].launch == single.launch);
+        }
+        decide_session_destroy(session);
+        decide_plan_destroy(plan);
+    }
+}
+
+TEST_CASE("C interface rejects invalid arguments", "[decide_c]") {
+    decide_params p = {};
+    uint8_t lcm[225] = {0};
+    decide_plan *plan = nullptr;
+    decide_session *session = nullptr;
+
+    lcm[1] = DECIDE_ORR;
+    REQUIRE(decide_plan_create(&p, lcm, 0, &plan) == DECIDE_EINVAL);
+    lcm[15] = DECIDE_ORR;
+    REQUIRE(decide_plan_create(&p, lcm, 0, &plan) == DECIDE_SUCCESS);
+    REQUIRE(decide_session_create(nullptr, &session) == DECIDE_EINVAL);
+    REQUIRE(decide_session_create(plan, &session) == DECIDE_SUCCESS);
+
+    decide_result result;
+    REQUIRE(decide_run(session, nullptr, nullptr, 3, &result) == DECIDE_EINVAL);
+    REQUIRE(decide_run(session, nullptr, nullptr, 0, &result) == DECIDE_SUCCESS);
+    decide_points bad = {nullptr, nullptr, 2};
+    REQUIRE(decide_run_batch(session, &bad, 1, &result) == DECIDE_EINVAL);
+
+    decide_session_destroy(session);
+    decide_plan_destroy(plan);
+}
+
+// Tests for DecideContext
+
+TEST_CASE("context decisions match the separate stages", "[DecideContext]") {
+    std::mt19937 gen(330);
+    DecideContext context;
+    double X[40], Y[40];
+    for (int round = 0; round < 2000; round++) {
+        int numPoints = gen() % 40;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 8);
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+
+        std::array<bool, 15> CMV = computeCMV(params);
+        std::array<std::array<bool, 15>, 15> PUM = generatePreliminaryUnlockingMatrix(CMV, LCM);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(PUM, PUV);
+
+        DecidePlan plan = makeDecidePlan(params, LCM, PUV);
+        REQUIRE(context.decide(plan, X, Y, numPoints) == launchDecision(FUV));
+        REQUIRE(context.CMV() == CMV);
+        REQUIRE(context.PUM() == PUM);
+        REQUIRE(context.FUV() == FUV);
+    }
+    REQUIRE(context.capacity() >= 39);
+}
+
+TEST_CASE("context runs the kernels of its plan for LICs 3 and 6", "[DecideContext]") {
+    std::mt19937 gen(332);
+    double X[40], Y[40];
+    Parameters_t params = randomParameters(gen, 40, X, Y);
+    DecidePlan plan = makeDecidePlan(params);
+    for (int lic = 0; lic < 15; lic++) plan.kernels[lic] = [](const Parameters_t &) { return true; };
+
+    // Only the LICs no feature column holds take their result from the plan
+    DecideContext context;
+    context.decide(plan, X, Y, 40);
+    std::array<bool, 15> CMV = computeCMV(params);
+    for (int lic = 0; lic < 15; lic++) {
+        REQUIRE(context.CMV()[lic] == (lic == 3 || lic == 6 ? true : CMV[lic]));
+    }
+}
+
+TEST_CASE("context does not allocate after warm-up", "[DecideContext]") {
+    std::mt19937 gen(331);
+    std::vector<double> X(500), Y(500);
+    Parameters_t params = randomParameters(gen, 500, X.data(), Y.data());
+    DecidePlan plan = makeDecidePlan(params, randomSymmetricLCM(gen, 2), std::array<bool, 15>{});
+
+    DecideContext context;
+    context.decide(plan, X.data(), Y.data(), 500);
+    int capacity = context.capacity();
+
+    long before = heapAllocations;
+    for (int n = 500; n >= 0; n -= 7) {
+        context.decide(plan, X.data(), Y.data(), n);
+    }
+    long after = heapAllocations;
+    REQUIRE(after == before);
+    REQUIRE(context.capacity() == capacity);
+
+    // The C session keeps its context between runs too
+    decide_params p = toDecideParams(params);
+    uint8_t lcm[225] = {0};
+    decide_plan *cPlan = nullptr;
+    decide_session *session = nullptr;
+    REQUIRE(decide_plan_create(&p, lcm, 0, &cPlan) == DECIDE_SUCCESS);
+    REQUIRE(decide_session_create(cPlan, &session) == DECIDE_SUCCESS);
+    decide_result result;
+    decide_run(session, X.data(), Y.data(), 500, &result);
+    before = heapAllocations;
+    for (int k = 0; k < 10; k++) {
+        decide_run(session, X.data(), Y.data(), 500 - k, &result);
+    }
+    after = heapAllocations;
+    REQUIRE(after == before);
+    decide_session_destroy(session);
+    decide_plan_destroy(cPlan);
+}
+
+// Tests for PointSetPool
+
+TEST_CASE("pooled point sets are aligned and decide like their copies", "[PointSetPool]") {
+    std::mt19937 gen(340);
+    PointSetPool pool(4096);
+    std::vector<std::vector<double>> X, Y;
+    std::vector<PointSetView> views;
+    Parameters_t params;
+    for (int k = 0; k < 300; k++) {
+        int numPoints = gen() % 60;
+        X.emplace_back(numPoints + 1);
+        Y.emplace_back(numPoints + 1);
+        params = randomParameters(gen, numPoints, X.back().data(), Y.back().data());
+        views.push_back(pool.add(X.back().data(), Y.back().data(), numPoints));
+    }
+    REQUIRE(pool.size() == 300);
+
+    for (size_t k = 0; k < views.size(); k++) {
+        const PointSetView &view = views[k];
+        if (view.NUMPOINTS == 0) continue;
+        REQUIRE((uintptr_t)view.X % POOL_ALIGNMENT == 0);
+        REQUIRE((uintptr_t)view.Y % POOL_ALIGNMENT == 0);
+        Parameters_t original = params;
+        original.X = X[k].data();
+        original.Y = Y[k].data();
+        original.NUMPOINTS = view.NUMPOINTS;
+        REQUIRE(computeCMV(withPoints(params, view)) == computeCMV(original));
+    }
+}
+
+TEST_CASE("pool reset reuses its blocks", "[PointSetPool]") {
+    PointSetPool pool(1024);
+    double X[100] = {0}, Y[100] = {0};
+    for (int k = 0; k < 50; k++) pool.add(X, Y, 30);
+    PointSetView large = pool.add(X, Y, 100);
+    REQUIRE(large.Y - large.X >= 100);
+    size_t blocks = pool.blockCount();
+
+    long before = heapAllocations;
+    pool.reset();
+    REQUIRE(pool.size() == 0);
+    for (int k = 0; k < 50; k++) pool.add(X, Y, 30);
+    pool.add(X, Y, 100);
+    long after = heapAllocations;
+    REQUIRE(after == before);
+    REQUIRE(pool.blockCount() == blocks);
+}
+
+// Tests for the float engine
+
+TEST_CASE("floatCompare keeps the doubleCompare tolerance for small values", "[floatCompare]") {
+    REQUIRE(floatCompare(0, 0.0000001f) == EQ);
+    REQUIRE(floatCompare(0, 0.000002f) == LT);
+    REQUIRE(floatCompare(1, 1.000002f) == LT);
+    REQUIRE(floatCompare(1000, 1000.0001f) == EQ);
+    REQUIRE(floatCompare(1000, 1000.01f) == LT);
+    REQUIRE(floatCompare(1000.01f, 1000) == GT);
+    REQUIRE(scalarCompare(1000.0, 1000.0001) == LT);
+}
+
+TEST_CASE("float CMV matches the double CMV", "[computeCMV]") {
+    std::mt19937 gen(350);
+    double X[60], Y[60];
+    float fx[60], fy[60];
+    int mismatches = 0;
+    for (int round = 0; round < 20000; round++) {
+        int numPoints = gen() % 60;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        for (int i = 0; i < numPoints; i++) {
+            fx[i] = (float)X[i];
+            fy[i] = (float)Y[i];
+        }
+        std::array<bool, 15> CMV = computeCMV(params);
+        REQUIRE(computeCMV(params, X, Y, numPoints) == CMV);
+        if (computeCMV(params, fx, fy, numPoints) != CMV) mismatches++;
+    }
+    REQUIRE(mismatches == 0);
+}
+
+// The hand-written LIC cases above, as the LIC each one tests and the statements setting up its input
+static const struct {
+    const char *name;
+    int lic;
+    void (*setup)(Parameters_t &params);
+} handWrittenLicCases[] = {
+    {"negative distance", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.LENGTH1 = -1;
+        params.X = new double[2]{0, 1};
+        params.Y = new double[2]{0, 0};
+    }},
+    {"too few points LIC 0", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 1;
+        params.LENGTH1 = 1;
+        params.X = new double[1]{0};
+        params.Y = new double[1]{0};
+    }},
+    {"2 points, dist longer than length1", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.LENGTH1 = 1;
+        params.X = new double[2]{0, 1};
+        params.Y = new double[2]{0, 1};
+    }},
+    {"three points distances less than length1", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{0, 0.5, 1};
+        params.Y = new double[3]{0, 0.5, 1};
+    }},
+    {"three points distances eq to length1", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{0, sqrt(1/2), sqrt(1/2) + sqrt(1/2)};
+        params.Y = new double[3]{0, sqrt(1/2), sqrt(1/2) + sqrt(1/2)};
+    }},
+    {"almost within length", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{0, 0, 0};
+        params.Y = new double[3]{0, 1.000001, 2.000002};
+    }},
+    {"point 4-5 outside of length", 0, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.LENGTH1 = 1;
+        params.X = new double[5]{0, 0, 1, 2, 0};
+        params.Y = new double[5]{0, 1, 1, 1, 0};
+    }},
+    {"LIC 1: Not enough points", 1, [](Parameters_t &params) {
+        params.NUMPOINTS = 1;
+        params.RADIUS1 = 1.0;
+        params.X = new double[1]{0};
+        params.Y = new double[1]{0};
+    }},
+    {"LIC 1: All points within circle", 1, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.RADIUS1 = 1.0;
+        params.X = new double[3]{0, 1, 2};
+        params.Y = new double[3]{0, 0.5, 0};
+    }},
+    {"LIC 1: One pair outside circle", 1, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.RADIUS1 = 1.0;
+        params.X = new double[3]{0, 3, 4};
+        params.Y = new double[3]{0, 0, 0};
+    }},
+    {"LIC 1: Multiple pairs outside circle", 1, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.RADIUS1 = 1.5;
+        params.X = new double[4]{0, 4, 8, 2};
+        params.Y = new double[4]{0, 0, 0, 0};
+    }},
+    {"LIC 2: Not enough points", 2, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.EPSILON = 0.1;
+        params.X = new double[2]{0, 1};
+        params.Y = new double[2]{0, 1};
+    }},
+    {"LIC 2: Collinear points", 2, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.EPSILON = 0.1;
+        params.X = new double[3]{0, 1, 2};
+        params.Y = new double[3]{0, 0, 0};
+    }},
+    {"LIC 2: Angle less than PI - EPSILON", 2, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.EPSILON = 0.1;
+        params.X = new double[3]{0, 1, 2};
+        params.Y = new double[3]{0, 1, 0};
+    }},
+    {"LIC 2: Angle greater than PI + EPSILON", 2, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.EPSILON = 0.1;
+        params.X = new double[3]{0, -1, -2};
+        params.Y = new double[3]{0, 1, 0};
+    }},
+    {"LIC 2: All angles within [PI - EPSILON, PI + EPSILON]", 2, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.EPSILON = 0.5;
+        params.X = new double[4]{0, 1, 2, 3};
+        params.Y = new double[4]{0, 0.1, 0.2, 0.3};
+    }},
+    {"less points than required", 3, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.AREA1 = 8;
+        params.X = new double[2]{10,10};
+        params.Y = new double[2]{10,10};
+    }},
+    {"AREA1 too small", 3, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.AREA1 = -1;
+        params.X = new double[3]{0, 0, 1};
+        params.Y = new double[3]{0, 2, 0};
+    }},
+    {"negative values in points", 3, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.AREA1 = 2;
+        params.X = new double[3]{0, 0, -2};
+        params.Y = new double[3]{0, -3, 0};
+    }},
+    {"precisely equal area", 3, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.AREA1 = 5;
+        params.X = new double[5]{0, 1, 2, 2, 7};
+        params.Y = new double[5]{0, 1, 0, 2, 2};
+    }},
+    {"too small area of triangle", 3, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.AREA1 = 5;
+        params.X = new double[5]{0, 1, 2, 3, 4};
+        params.Y = new double[5]{0, 0.5, 0, 0.5, 0};
+    }},
+    {"area big enough", 3, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.AREA1 = 2;
+        params.X = new double[5]{0, 10, 15, 20, 43};
+        params.Y = new double[5]{5, 0, 10, 13, 2};
+    }},
+    {"Quad outside of specs", 4, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.QUADS = 0;
+        params.X = new double[5]{0, 10, 15, 20, 43};
+        params.Y = new double[5]{5, 0, 10, 13, 2};
+    }},
+    {"Want > 3 quads, but only have 1", 4, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.QUADS = 3;
+        params.Q_PTS = 3;
+        params.X = new double[5]{1, 2, 3, 4, 4};
+        params.Y = new double[5]{1, 2, 3, 4, 4};
+    }},
+    {"Want > 3 quads, have 4", 4, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.QUADS = 3;
+        params.Q_PTS = 4;
+        params.X = new double[4]{1, -2, -1, 4};
+        params.Y = new double[4]{1, 2, -1, -4};
+    }},
+    {"Want > 3 quads, have 3 on xy axis and one in quad4", 4, [](Parameters_t &params) {
+        // The test above claims 5 points but only has 4
+        params.NUMPOINTS = 4;
+        params.QUADS = 3;
+        params.Q_PTS = 4;
+        params.X = new double[4]{0, -1, 0, 4};
+        params.Y = new double[4]{1, 0, -1, -4};
+    }},
+    {"Want > 3 quads, have 4 in the middle", 4, [](Parameters_t &params) {
+        params.NUMPOINTS = 6;
+        params.QUADS = 3;
+        params.Q_PTS = 4;
+        params.X = new double[6]{0, 0, 4, -4, -1, 0};
+        params.Y = new double[6]{0, 0, -4, 4, -1, 0};
+    }},
+    {"LIC 5: Not enough points", 5, [](Parameters_t &params) {
+        params.NUMPOINTS = 1;
+        params.X = new double[1]{1.0};
+        params.Y = new double[1]{1.0};
+    }},
+    {"LIC 5: No consecutive decreasing x-coordinates", 5, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.X = new double[4]{1.0, 2.0, 3.0, 4.0};
+        params.Y = new double[4]{1.0, 1.0, 1.0, 1.0};
+    }},
+    {"LIC 5: One pair of consecutive decreasing x-coordinates", 5, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.X = new double[4]{4.0, 3.0, 5.0, 6.0};
+        params.Y = new double[4]{1.0, 1.0, 1.0, 1.0};
+    }},
+    {"LIC 5: Multiple pairs of consecutive decreasing x-coordinates", 5, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.X = new double[5]{5.0, 3.0, 4.0, 2.0, 1.0};
+        params.Y = new double[5]{1.0, 1.0, 1.0, 1.0, 1.0};
+    }},
+    {"too few points", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.N_PTS = 3;
+        params.DIST = 1.0;
+        params.X = new double[2]{0, 1};
+        params.Y = new double[2]{0, 0};
+    }},
+    {"base line w/o dev", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.N_PTS = 3;
+        params.DIST = 2.0;
+        params.X = new double[5]{0, 1, 2, 3, 4};
+        params.Y = new double[5]{0, 0, 0, 0, 0};
+    }},
+    {"base line w/ dev", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.N_PTS = 3;
+        params.DIST = 1.0;
+        params.X = new double[5]{0, 1, 2, 3, 4};
+        params.Y = new double[5]{0, 1.5, 0, 0, 0};
+    }},
+    {"point w/o dev", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.N_PTS = 4;
+        params.DIST = 2.0;
+        params.X = new double[4]{0, 1, 2, 0};
+        params.Y = new double[4]{0, 0, 0, 0};
+    }},
+    {"point w/ dev", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.N_PTS = 4;
+        params.DIST = 1.0;
+        params.X = new double[4]{0, 1, 2, 0};
+        params.Y = new double[4]{0, 1, 2, 0};
+    }},
+    {"line exactly on dist", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.N_PTS = 3;
+        params.DIST = 1.0;
+        params.X = new double[3]{0, 1, 2};
+        params.Y = new double[3]{0, 1, 0};
+    }},
+    {"almost within", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.N_PTS = 3;
+        params.DIST = 1.0;
+        params.X = new double[4]{0, 1, 2, 3};
+        params.Y = new double[4]{0, 1.00000001, 0, 0};
+    }},
+    {"line w/ negative doubles", 6, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.N_PTS = 3;
+        params.DIST = 2.0;
+        params.X = new double[4]{-1, 0, 1, 2};
+        params.Y = new double[4]{-1, 0, 1, 2};
+    }},
+    {"not enough points (NUMPOINTS)", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.X = new double[2]{1, 2};
+        params.Y = new double[2]{2, 1};
+    }},
+    {"too small value (K_PTS)", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 0;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{1, 2, 3};
+        params.Y = new double[3]{3, 2, 1};
+    }},
+    {"too large value (K_PTS)", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 2;
+        params.LENGTH1 = 0;
+        params.X = new double[3]{1, 2, 3};
+        params.Y = new double[3]{3, 2, 1};
+    }},
+    {"too small value (LENGTH1)", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 0;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{1, 2, 3};
+        params.Y = new double[3]{3, 2, 1};
+    }},
+    {"distance = LENGTH1, not allowed", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{1, 2, 1};
+        params.Y = new double[3]{2, 2, 1};
+    }},
+    {"negative values, not allowed", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{1, 2, 1};
+        params.Y = new double[3]{-2, 2, -1};
+    }},
+    {"negative values, allowed", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.X = new double[3]{1, 2, 1};
+        params.Y = new double[3]{-1, 2, 1};
+    }},
+    {"allowed testcase", 7, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.K_PTS = 1;
+        params.LENGTH1 = 5;
+        params.X = new double[5]{1, 10, 1, 19, 0};
+        params.Y = new double[5]{10, 2, 7, 6, 0};
+    }},
+    {"points within circle", 8, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 5.0;
+        params.X = new double[5]{0, 1, 2, 3, 4};
+        params.Y = new double[5]{0, 1, 2, 3, 4};
+    }},
+    {"points outside circle", 8, [](Parameters_t &params) {
+        params.NUMPOINTS = 6;
+        params.A_PTS = 2;
+        params.B_PTS = 1;
+        params.RADIUS1 = 2.0;
+        params.X = new double[6]{0, 1, 5, 6, 8, 10};
+        params.Y = new double[6]{0, 1, 5, 6, 8, 10};
+    }},
+    {"triangle fits within circle", 8, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 3.0;
+        params.X = new double[5]{0, 1, 2, 2, 3};
+        params.Y = new double[5]{0, 1, 1.5, 1, 0};
+    }},
+    {"triangle exceeds circle", 8, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 1.5;
+        params.X = new double[5]{0, 1, 2, 5, 6};
+        params.Y = new double[5]{0, 1, 4, 5, 6};
+    }},
+    {"collinear points within circle", 8, [](Parameters_t &params) {
+        params.NUMPOINTS = 6;
+        params.A_PTS = 2;
+        params.B_PTS = 1;
+        params.RADIUS1 = 5.0;
+        params.X = new double[6]{0, 2, 4, 6, 8, 10};
+        params.Y = new double[6]{0, 0, 0, 0, 0, 0};
+    }},
+    {"boundary condition - on the edge of the circle", 8, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 2.0;
+        params.X = new double[5]{0, 2, 4, 1, 3};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"C_PTS under threshold", 9, [](Parameters_t &params) {
+        params.C_PTS = 0;
+        params.D_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.EPSILON = -PI;
+        params.X = new double[5]{1, 1, 0, 1, 0};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"D_PTS under threshold", 9, [](Parameters_t &params) {
+        params.C_PTS = 1;
+        params.D_PTS = 0;
+        params.NUMPOINTS = 5;
+        params.EPSILON = -PI;
+        params.X = new double[5]{1, 2, 0, 1, 0};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"Numpoints under threshold", 9, [](Parameters_t &params) {
+        params.C_PTS = 1;
+        params.D_PTS = 0;
+        params.NUMPOINTS = 3;
+        params.EPSILON = -PI;
+        params.X = new double[5]{1, 2, 0, 1, 0};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"90 degree angle, LT 180 allowed", 9, [](Parameters_t &params) {
+        params.C_PTS = 1;
+        params.D_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.EPSILON = 0;
+        params.X = new double[5]{1, 2, 0, 1, 0};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"90 degree angle, LT 90 allowed", 9, [](Parameters_t &params) {
+        params.C_PTS = 1;
+        params.D_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.EPSILON = PI / 2;
+        params.X = new double[5]{1, 2, 0, 1, 0};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"E_PTS and F_PTS below allowed threshold", 10, [](Parameters_t &params) {
+        params.E_PTS = 0;
+        params.F_PTS = 0;
+        params.NUMPOINTS = 5;
+        params.AREA1 = 1;
+        params.X = new double[5]{0, 2, 4, 1, 3};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"E PTS + F PTS > NUMPOINTS - 3, this is not allowed", 10, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 3;
+        params.NUMPOINTS = 7;
+        params.AREA1 = 1;
+        params.X = new double[7]{0, 2, 4, 1, 3, 4, 5};
+        params.Y = new double[7]{0, 2, 0, 1, 1, 4, 5};
+    }},
+    {"NUMPOINTS < 5, not allowed", 10, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 4;
+        params.AREA1 = 1;
+        params.X = new double[4]{100, 0, 2, 1};
+        params.Y = new double[4]{0, 2, 0, 1};
+    }},
+    {"edge case: the area of the triangle is equal to AREA1", 10, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 8;
+        params.AREA1 = 12;
+        params.X = new double[8]{0, 1, 2, 12, 3, 12, 0, 4};
+        params.Y = new double[8]{0, 2, 2, 0, 2, 0, 2, 2};
+    }},
+    {"negative values, scenario should be ok", 10, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 8;
+        params.AREA1 = 20;
+        params.X = new double[8]{-100, 0, 2, 0, 1, 12, -50, 2};
+        params.Y = new double[8]{0, -1, 3, 100, 0, 32, 50, -2};
+    }},
+    {"allowed scenario", 10, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 8;
+        params.AREA1 = 20;
+        params.X = new double[8]{100, 0, 2, 0, 1, 12, 50, 2};
+        params.Y = new double[8]{0, 1, 3, 100, 0, 32, 50, 2};
+    }},
+    {"G_PTS too small", 11, [](Parameters_t &params) {
+        params.G_PTS = 0;
+        params.NUMPOINTS = 3;
+        params.X = new double[3]{3, 2, 1};
+    }},
+    {"G_PTS too large", 11, [](Parameters_t &params) {
+        params.G_PTS = 2;
+        params.NUMPOINTS = 3;
+        params.X = new double[3]{3, 2, 1};
+    }},
+    {"X[i] = X[j], not allowed", 11, [](Parameters_t &params) {
+        params.G_PTS = 1;
+        params.NUMPOINTS = 3;
+        params.X = new double[3]{1, 1, 1};
+    }},
+    {"NUMPOINTS < 3, not allowed", 11, [](Parameters_t &params) {
+        params.G_PTS = 1;
+        params.NUMPOINTS = 2;
+        params.X = new double[2]{1, 1};
+    }},
+    {"negative values, should not be allowed", 11, [](Parameters_t &params) {
+        params.G_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.X = new double[5]{1, -3, 2, 2, 3};
+    }},
+    {"both negative values, should not be allowed", 11, [](Parameters_t &params) {
+        params.G_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.X = new double[5]{1, -3, 2, -2, 3};
+    }},
+    {"negative values, should be allowed", 11, [](Parameters_t &params) {
+        params.G_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.X = new double[5]{1, 3, 2, -4, 3};
+    }},
+    {"appropriate scenario, should be allowed", 11, [](Parameters_t &params) {
+        params.G_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.X = new double[5]{1, 5, 2, 4, 3};
+    }},
+    {"lic12 too few points", 12, [](Parameters_t &params) {
+        params.NUMPOINTS = 2;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.LENGTH2 = 1;
+        params.X = new double[2]{1, 2};
+        params.Y = new double[2]{2, 1};
+    }},
+    {"fulfill L2 but not L1", 12, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.LENGTH2 = 1;
+        params.X = new double[3]{1, 1, 1};
+        params.Y = new double[3]{1, 1, 1};
+    }},
+    {"fulfill L1 but not L2", 12, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.LENGTH2 = 1;
+        params.X = new double[3]{1, 5, 10};
+        params.Y = new double[3]{1, 5, 10};
+    }},
+    {"fulfill both", 12, [](Parameters_t &params) {
+        params.NUMPOINTS = 3;
+        params.K_PTS = 1;
+        params.LENGTH1 = 1;
+        params.LENGTH2 = 5;
+        params.X = new double[3]{1, 1, 3};
+        params.Y = new double[3]{1, 1, 3};
+    }},
+    {"fulfill in different", 12, [](Parameters_t &params) {
+        params.NUMPOINTS = 6;
+        params.K_PTS = 2;
+        params.LENGTH1 = 5;
+        params.LENGTH2 = 1.5;
+        params.X = new double[6]{1, 1, 1, 2, 4, 8};
+        params.Y = new double[6]{1, 1, 1, 1, 1, 1};
+    }},
+    {"A_PTS less than 1", 13, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 0;
+        params.B_PTS = 1;
+        params.RADIUS1 = 5.0;
+        params.X = new double[5]{-2, 1, 2, 3, 0};
+        params.Y = new double[5]{0, 1, 0, 3, 2};
+    }},
+    {"B_PTS less than 1", 13, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 0;
+        params.RADIUS1 = 5.0;
+        params.X = new double[5]{-2, 1, 2, 3, 0};
+        params.Y = new double[5]{0, 1, 0, 3, 2};
+    }},
+    {"NUMPOINTS less than 5", 13, [](Parameters_t &params) {
+        params.NUMPOINTS = 4;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 5.0;
+        params.X = new double[4]{-2, 1, 2, 3};
+        params.Y = new double[4]{0, 1, 0, 3};
+    }},
+    {"All fit in radius1", 13, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 10;
+        params.RADIUS2 = 10;
+        params.X = new double[5]{-2, 1, 2, 3, 0};
+        params.Y = new double[5]{0, 1, 0, 3, 2};
+    }},
+    {"One fit in radius2, one does not in radius1", 13, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 1.99;
+        params.RADIUS2 = 10.0;
+        params.X = new double[5]{-2, 1, 2, 3, 0};
+        params.Y = new double[5]{0, 1, 0, 3, 2};
+    }},
+    {"Multiple fit in radius2, multiple do not in radius1", 13, [](Parameters_t &params) {
+        params.NUMPOINTS = 5;
+        params.A_PTS = 1;
+        params.B_PTS = 1;
+        params.RADIUS1 = 1.99;
+        params.RADIUS2 = 10.0;
+        params.X = new double[7]{-2, 1, 2, 3, 0, 0, 25};
+        params.Y = new double[7]{0, 1, 0, 3, 2, 0, -100};
+    }},
+    {"E_PTS and F_PTS too small", 14, [](Parameters_t &params) {
+        params.E_PTS = 0;
+        params.F_PTS = 0;
+        params.NUMPOINTS = 5;
+        params.AREA1 = 12;
+        params.AREA2 = 12;
+        params.X = new double[5]{0, 2, 4, 1, 3};
+        params.Y = new double[5]{0, 2, 0, 1, 1};
+    }},
+    {"NUMPOINTS too small", 14, [](Parameters_t &params) {
+        params.E_PTS = 1;
+        params.F_PTS = 1;
+        params.NUMPOINTS = 4;
+        params.AREA1 = 12;
+        params.AREA2 = 12;
+        params.X = new double[4]{100, 0, 2, 1};
+        params.Y = new double[4]{0, 2, 0, 1};
+    }},
+    {"AREA2 too small", 14, [](Parameters_t &params) {
+        params.E_PTS = 1;
+        params.F_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.AREA1 = 12;
+        params.AREA2 = 0;
+        params.X = new double[5]{100, 0, 2, 1, 1};
+        params.Y = new double[5]{0, 2, 0, 1, 2};
+    }},
+    {"A > AREA1 fulfilled; A < AREA2 not fulfilled", 14, [](Parameters_t &params) {
+        params.E_PTS = 1;
+        params.F_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.AREA1 = 12;
+        params.AREA2 = 12;
+        params.X = new double[5]{100, 0, 1, 1, 1};
+        params.Y = new double[5]{0, 2, 100, 1, 5};
+    }},
+    {"A > AREA1 not fulfilled; A < AREA2 fulfilled", 14, [](Parameters_t &params) {
+        params.E_PTS = 1;
+        params.F_PTS = 1;
+        params.NUMPOINTS = 5;
+        params.AREA1 = 12;
+        params.AREA2 = 12;
+        params.X = new double[5]{0, 0, 1, 1, 2};
+        params.Y = new double[5]{0, 2, 0, 1, 0};
+    }},
+    {"edge case: A = AREA1", 14, [](Parameters_t &params) {
+        params.E_PTS = 1;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 6;
+        params.AREA1 = 12;
+        params.AREA2 = 12;
+        params.X = new double[6]{0, 100, 0, 12, 12, 12};
+        params.Y = new double[6]{0, 2, 2, 12, 13, 0};
+    }},
+    {"edge case: A = AREA2", 14, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 7;
+        params.AREA1 = 12;
+        params.AREA2 = 3;
+        params.X = new double[7]{0, 0, 100, 6, 2, 1, 0};
+        params.Y = new double[7]{0, 2, 0, 0, 1, 1, 1};
+    }},
+    {"negative values, ok scenario", 14, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 8;
+        params.AREA1 = 20;
+        params.AREA2 = 12;
+        params.X = new double[8]{-100, 0, 2, 0, 1, 12, -50, 2};
+        params.Y = new double[8]{0, -1, 3, 100, 0, 32, 50, -2};
+    }},
+    {"ok scenario", 14, [](Parameters_t &params) {
+        params.E_PTS = 2;
+        params.F_PTS = 2;
+        params.NUMPOINTS = 8;
+        params.AREA1 = 20;
+        params.AREA2 = 12;
+        params.X = new double[8]{100, 0, 2, 0, 1, 12, 50, 2};
+        params.Y = new double[8]{0, 1, 3, 100, 0, 32, 50, 2};
+    }},
+};
+
+TEST_CASE("float CMV matches the double CMV on the hand-written LIC cases", "[computeCMV]") {
+    for (const auto &testCase : handWrittenLicCases) {
+        INFO(testCase.name);
+        Parameters_t params = {};
+        testCase.setup(params);
+        int numPoints = std::max(params.NUMPOINTS, 0);
+        // The LIC 5 and 11 cases leave out the Y coordinates they never read
+        std::vector<double> zeros(numPoints, 0);
+        if (params.Y == nullptr) params.Y = zeros.data();
+        std::vector<float> fx(numPoints), fy(numPoints);
+        for (int i = 0; i < numPoints; i++) {
+            fx[i] = (float)params.X[i];
+            fy[i] = (float)params.Y[i];
+        }
+        bool expected = evaluateLic(testCase.lic, params);
+        REQUIRE(computeCMV(params, params.X, params.Y, params.NUMPOINTS)[testCase.lic] == expected);
+        REQUIRE(computeCMV(params, fx.data(), fy.data(), params.NUMPOINTS)[testCase.lic] == expected);
+    }
+}
+
+TEST_CASE("track lanes match the hand-written LIC cases", "[MultiTrackSet]") {
+    double shortX[1] = {7}, shortY[1] = {-3};
+    for (const auto &testCase : handWrittenLicCases) {
+        INFO(testCase.name);
+        Parameters_t params = {};
+        testCase.setup(params);
+        int numPoints = std::max(params.NUMPOINTS, 0);
+        std::vector<double> zeros(numPoints, 0);
+        if (params.Y == nullptr) params.Y = zeros.data();
+
+        // The case in every other lane, between one point tracks that have no window at all
+        MultiTrackSet tracks;
+        for (int t = 0; t < TRACK_LANES; t++) {
+            if (t % 2) tracks.addTrack(params.X, params.Y, numPoints);
+            else tracks.addTrack(shortX, shortY, 1);
+        }
+        bool expected = evaluateLic(testCase.lic, params);
+        std::vector<uint16_t> masks = tracks.evaluate(params);
+        for (int t = 1; t < TRACK_LANES; t += 2) {
+            REQUIRE((masks[t] >> testCase.lic & 1) == expected);
+        }
+    }
+}
+
+// Tests for the exact fixed-point mode
+
+TEST_CASE("exact CMV matches the double CMV on integer points", "[computeExactCMV]") {
+    std::mt19937 gen(360);
+    double X[40], Y[40];
+    int32_t ix[40], iy[40];
+    int64_t lx[40], ly[40];
+    // LICs whose double geometry has no quirk or rounding issue on small integer points. LICs 8 and
+    // 13 compare products with the quantized radii, which is lossless only for whole radii
+    const int compared[] = {0, 1, 3, 4, 5, 6, 7, 11, 12};
+    for (int round = 0; round < 20000; round++) {
+        int numPoints = gen() % 40;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        bool wholeRadii = round % 2 == 0;
+        if (wholeRadii) {
+            params.RADIUS1 = std::round(params.RADIUS1);
+            params.RADIUS2 = std::round(params.RADIUS2);
+        }
+        for (int i = 0; i < numPoints; i++) {
+            lx[i] = ix[i] = (int32_t)X[i];
+            ly[i] = iy[i] = (int32_t)Y[i];
+        }
+        ExactPlan plan = makeExactPlan(params, 1);
+        std::array<bool, 15> exact = computeExactCMV(plan, ix, iy, numPoints);
+        REQUIRE(computeExactCMV(plan, lx, ly, numPoints) == exact);
+
+        std::array<bool, 15> CMV = computeCMV(params);
+        for (int lic : compared) {
+            REQUIRE(exact[lic] == CMV[lic]);
+        }
+        if (wholeRadii) {
+            REQUIRE(exact[8] == CMV[8]);
+            REQUIRE(exact[13] == CMV[13]);
+        }
+    }
+}
+
+TEST_CASE("exact mode scales thresholds to fixed-point units", "[makeExactPlan]") {
+    Parameters_t params = {};
+    params.LENGTH1 = 2.5;
+    params.LENGTH2 = 1.5;
+    params.RADIUS1 = 1;
+    params.RADIUS2 = 1;
+    params.AREA1 = 3;
+    params.AREA2 = 1;
+    params.K_PTS = 1;
+    params.E_PTS = 1;
+    params.F_PTS = 1;
+
+    // Millimetres: a 2.5005 m step is longer than LENGTH1, a 2.5 m step is not
+    ExactPlan plan = makeExactPlan(params, 1000);
+    int32_t X[5] = {0, 2500, 0, 2501, 5002};
+    int32_t Y[5] = {0, 0, 0, 0, 0};
+    REQUIRE(computeExactCMV(plan, X, Y, 3)[0] == false);
+    REQUIRE(computeExactCMV(plan, X, Y, 4)[0] == true);
+    REQUIRE(plan.length1Sq == (ExactInt)2500 * 2500);
+    REQUIRE(plan.length2Sq == (ExactInt)1500 * 1500);
+    REQUIRE(plan.area1Twice == (ExactInt)6000000);
+
+    // A triangle of exactly AREA1 is not larger than AREA1
+    int32_t tx[5] = {0, 9, 3000, 9, 0};
+    int32_t ty[5] = {0, 9, 0, 9, 2000};
+    REQUIRE(computeExactCMV(plan, tx, ty, 5)[10] == false);
+    ty[4] = 2001;
+    REQUIRE(computeExactCMV(plan, tx, ty, 5)[10] == true);
+}
+
+TEST_CASE("exact angles and large coordinates", "[computeExactCMV]") {
+    Parameters_t params = {};
+    params.EPSILON = 0;
+    params.RADIUS1 = 1;
+    params.RADIUS2 = 1;
+    params.A_PTS = 1;
+    params.B_PTS = 1;
+    ExactPlan plan = makeExactPlan(params, 1);
+
+    // Exactly straight is never bent, whatever the magnitudes
+    int64_t X[5] = {-1000000000, 1, 1000000002, 0, 0};
+    int64_t Y[5] = {-999999999, 2, 1000000003, 0, 0};
+    REQUIRE(exactCoordinatesInRange(X, Y, 5));
+    REQUIRE(computeExactCMV(plan, X, Y, 3)[2] == false);
+    Y[2] += 1;
+    REQUIRE(computeExactCMV(plan, X, Y, 3)[2] == true);
+
+    // Huge nearly flat triangle: circumradius far beyond RADIUS1, so LIC 13 raises bit 0 only
+    int64_t hx[5] = {-EXACT_COORD_LIMIT, 0, 0, 0, EXACT_COORD_LIMIT};
+    int64_t hy[5] = {-EXACT_COORD_LIMIT, 0, 1, 0, EXACT_COORD_LIMIT - 1};
+    std::array<bool, 15> CMV = computeExactCMV(plan, hx, hy, 5);
+    REQUIRE(CMV[8] == true);
+    REQUIRE(CMV[13] == false);
+    params.RADIUS2 = 1e19;
+    REQUIRE(computeExactCMV(makeExactPlan(params, 1), hx, hy, 5)[13] == true);
+
+    int64_t outside[1] = {EXACT_COORD_LIMIT + 1};
+    REQUIRE_FALSE(exactCoordinatesInRange(outside, outside, 1));
+}
+
+TEST_CASE("exact 256-bit product comparison", "[exactProductGreater]") {
+    ExactUInt big = (ExactUInt)1 << 100;
+    REQUIRE(exactProductGreater(big, (ExactUInt)1 << 20, (ExactInt)1 << 60, ((ExactUInt)1 << 60) - 1));
+    REQUIRE_FALSE(exactProductGreater(big, (ExactUInt)1 << 20, (ExactInt)1 << 60, ((ExactUInt)1 << 60) + 1));
+    REQUIRE_FALSE(exactProductGreater(big, (ExactUInt)1 << 20, (ExactInt)1 << 60, (ExactUInt)1 << 60));
+    REQUIRE(exactProductGreater(0, 0, -1, 1));
+    REQUIRE(exactProductGreater(~(ExactUInt)0, 3, ((ExactInt)1 << 126), 7));
+}
+
+// Tests for the robust predicates
+
+TEST_CASE("robust orientation is exact near collinear points", "[robustOrientation]") {
+    std::mt19937_64 gen(370);
+    long before = robustExactEvaluations();
+    for (int round = 0; round < 20000; round++) {
+        // a, b and a + k (b - a) moved by at most one unit, coordinates up to 2^40 are exact doubles
+        int64_t ax = (int64_t)(gen() >> 24) - ((int64_t)1 << 39), ay = (int64_t)(gen() >> 24) - ((int64_t)1 << 39);
+        int64_t dx = (int64_t)(gen() % 2001) - 1000, dy = (int64_t)(gen() % 2001) - 1000;
+        int64_t k = (int64_t)(gen() % 1000000);
+        int64_t cx = ax + k * dx + (int64_t)(gen() % 3) - 1, cy = ay + k * dy + (int64_t)(gen() % 3) - 1;
+        int64_t X[3] = {ax, ax + dx, cx}, Y[3] = {ay, ay + dy, cy};
+
+        IntegerPoints<int64_t> pts = {X, Y};
+        ExactInt cross = exactCross(pts, 0, 1, 2);
+        int expected = cross > 0 ? 1 : (cross < 0 ? -1 : 0);
+        REQUIRE(robustOrientation(ax, ay, ax + dx, ay + dy, cx, cy) == expected);
+    }
+    REQUIRE(robustExactEvaluations() > before);
+}
+
+TEST_CASE("robust comparisons settle ties exactly", "[robustCompareCircumradius]") {
+    // Right triangle with hypotenuse 10 and circumradius 5, scaled to other units
+    for (double unit : {1.0, 0.1, 1e-5, 3e7}) {
+        REQUIRE(robustCompareCircumradius(0, 0, 6 * unit, 0, 0, 8 * unit, 5.5 * unit) == -1);
+        REQUIRE(robustCompareCircumradius(0, 0, 6 * unit, 0, 0, 8 * unit, 4.5 * unit) == 1);
+    }
+    REQUIRE(robustCompareCircumradius(0, 0, 6, 0, 0, 8, 5) == 0);
+    REQUIRE(robustCompareDistance(0, 0, 3, 4, 5) == 0);
+    REQUIRE(robustCompareDistance(0, 0, 3, 4, std::nextafter(5.0, 0.0)) == 1);
+    REQUIRE(robustCompareLineDistance(0, 0, 4, 0, 1, 3, 3) == 0);
+    REQUIRE(robustCompareLineDistance(0, 0, 4, 0, 1, std::nextafter(3.0, 4.0), 3) == 1);
+    REQUIRE(robustCompareMidpointDistance(0, 3, -1, 0, 1, 0, 3) == 0);
+    REQUIRE(robustCompareLengths(0, 0, 3, 4, 1, 1, 6, 1) == 0);
+    REQUIRE(robustCompareDeviation(-1, 0, 0, 0, 1, 0, 1, 0) == 0);
+    REQUIRE(robustCompareDeviation(-1, 0, 0, 0, 1, 1e-300, 1, 0) == 1);
+}
+
+TEST_CASE("robust CMV matches the exact mode on integer points", "[computeRobustCMV]") {
+    std::mt19937 gen(371);
+    double X[40], Y[40];
+    int32_t ix[40], iy[40];
+    long before = robustExactEvaluations();
+    for (int round = 0; round < 10000; round++) {
+        int numPoints = gen() % 40;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        params.RADIUS1 = std::round(params.RADIUS1);
+        params.RADIUS2 = std::round(params.RADIUS2);
+        for (int i = 0; i < numPoints; i++) {
+            ix[i] = (int32_t)X[i];
+            iy[i] = (int32_t)Y[i];
+        }
+        std::array<bool, 15> robust = computeRobustCMV(params);
+        std::array<bool, 15> exact = computeExactCMV(makeExactPlan(params, 1), ix, iy, numPoints);
+        std::array<bool, 15> CMV = computeCMV(params);
+        for (int lic = 0; lic < 15; lic++) {
+            if (lic == 6 || lic == 8 || lic == 9 || lic == 13) {
+                REQUIRE(robust[lic] == exact[lic]);
+            } else {
+                REQUIRE(robust[lic] == CMV[lic]);
+            }
+        }
+    }
+    // Small integer points are full of exact ties, so the exact stage has to run
+    REQUIRE(robustExactEvaluations() > before);
+}
+
+TEST_CASE("robust LIC 13 sees small triangles the tolerance calls collinear", "[computeRobustCMV]") {
+    double X[5] = {0, 9, 1e-4, 9, 0};
+    double Y[5] = {0, 9, 0, 9, 1e-4};
+    Parameters_t params = {};
+    params.NUMPOINTS = 5;
+    params.X = X;
+    params.Y = Y;
+    params.A_PTS = 1;
+    params.B_PTS = 1;
+    params.RADIUS1 = 5e-5;
+    params.RADIUS2 = 1e-4;
+    params.EPSILON = 0;
+    params.C_PTS = 1;
+    params.D_PTS = 1;
+
+    // Circumradius of the right triangle is 7.07e-5
+    REQUIRE(computeCMV(params)[13] == false);
+    REQUIRE(computeRobustCMV(params)[13] == true);
+
+    // Random reals rarely need the exact stage
+    std::mt19937 gen(372);
+    std::uniform_real_distribution<double> coordinate(-100, 100);
+    double rx[50], ry[50];
+    params.NUMPOINTS = 50;
+    params.X = rx;
+    params.Y = ry;
+    params.DIST = 10;
+    params.N_PTS = 5;
+    params.RADIUS1 = 30;
+    params.RADIUS2 = 60;
+    params.EPSILON = 0.5;
+    long before = robustExactEvaluations();
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 50; i++) {
+            rx[i] = coordinate(gen);
+            ry[i] = coordinate(gen);
+        }
+        computeRobustCMV(params);
+    }
+    REQUIRE(robustExactEvaluations() - before < 10);
+}
+
+// Tests for the feature columns
+
+TEST_CASE("feature column CMV matches computeCMV", "[FeatureColumns]") {
+    std::mt19937 gen(380);
+    FeatureColumns features;
+    double X[60], Y[60];
+    for (int round = 0; round < 3000; round++) {
+        int numPoints = gen() % 60;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        // Repeat some points so the coincidence checks of LICs 2 and 9 are exercised
+        for (int i = 1; i < numPoints; i++) {
+            if (gen() % 4 == 0) {
+                X[i] = X[i-1];
+                Y[i] = Y[i-1];
+            }
+        }
+        features.build(params);
+        REQUIRE(computeCMV(features, params) == computeCMV(params));
+        REQUIRE(computeCMV(features, params, makeDecidePlan(params).kernels) == computeCMV(params));
+    }
+}
+
+TEST_CASE("feature columns are aligned and shared between LICs", "[FeatureColumns]") {
+    std::mt19937 gen(381);
+    double X[50], Y[50];
+    Parameters_t params = randomParameters(gen, 50, X, Y);
+    params.LENGTH1 = 1;
+    params.K_PTS = 2;
+    params.A_PTS = 1;
+    params.B_PTS = 1;
+    params.C_PTS = 0;
+    params.D_PTS = 2;
+
+    FeatureColumns features(50);
+    features.build(params);
+    for (int lag : {1, 3, 2, 4}) {
+        const LagColumns *columns = features.lag(lag);
+        REQUIRE(columns != nullptr);
+        REQUIRE((uintptr_t)columns->dx % FEATURE_ALIGNMENT == 0);
+        REQUIRE((uintptr_t)columns->normSq % FEATURE_ALIGNMENT == 0);
+        for (int i = 0; i + lag < 50; i++) {
+            REQUIRE(columns->dx[i] == X[i + lag] - X[i]);
+            REQUIRE(columns->normSq[i] == columns->dx[i] * columns->dx[i] + columns->dy[i] * columns->dy[i]);
+        }
+    }
+    REQUIRE(features.lag(5) == nullptr);
+    for (int i = 0; i < 50; i++) {
+        REQUIRE(features.quadrants()[i] == pointQuadrant(X[i], Y[i]));
+    }
+
+    // Rebuilding a smaller point set reuses the storage
+    long before = heapAllocations;
+    params.NUMPOINTS = 30;
+    features.build(params);
+    REQUIRE(heapAllocations == before);
+}
+
+// Tests for the descending pair kernel
+
+TEST_CASE("descending pair kernel matches the scalar LIC 5 and LIC 11 tests", "[anyDescendingPair]") {
+    std::mt19937 gen(390);
+    const double special[] = {0.0, -0.0, 1.0, -1.0, INFINITY, -INFINITY, NAN, 1e-310, -1e-310};
+    double X[70];
+    for (int round = 0; round < 5000; round++) {
+        int numPoints = gen() % 70;
+        // Non-decreasing points with one descending pair at a random place, or none
+        for (int i = 0; i < numPoints; i++) X[i] = i;
+        if (numPoints > 1 && gen() % 4 != 0) {
+            int at = gen() % numPoints;
+            X[at] = special[gen() % 9] + (gen() % 2 ? 100 : -100);
+        }
+        if (gen() % 5 == 0 && numPoints > 0) X[gen() % numPoints] = special[gen() % 9];
+
+        int lag = 1 + gen() % 10;
+        int count = numPoints - lag;
+        bool expected = false;
+        for (int i = 0; i < count; i++) {
+            if (X[i + lag] - X[i] < 0) expected = true;
+        }
+        REQUIRE(anyDescendingPair(X, lag, count) == expected);
+    }
+}
+
+TEST_CASE("LIC 5 and LIC 11 kernels match the runtime LICs", "[selectLicKernel]") {
+    std::mt19937 gen(391);
+    double X[60], Y[60];
+    for (int round = 0; round < 2000; round++) {
+        int numPoints = gen() % 60;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        // Mostly increasing X, so a descending pair is found late if at all
+        for (int i = 0; i < numPoints; i++) X[i] = i + (gen() % 20 == 0 ? -3.0 : 0.0);
+        params.G_PTS = gen() % 12 - 1;
+        REQUIRE(selectLicKernel(5, params)(params) == lic5(params));
+        REQUIRE(selectLicKernel(11, params)(params) == lic11(params));
+        REQUIRE(computeCMV<double>(params, X, Y, numPoints) == computeCMV(params));
+    }
+}
+
+// Tests for RangeIndex
+
+TEST_CASE("range CMV matches computeCMV on a copy of the range", "[RangeIndex]") {
+    std::mt19937 gen(400);
+    double X[300], Y[300], rangeX[300], rangeY[300];
+    for (int round = 0; round < 40; round++) {
+        int numPoints = gen() % 300;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        RangeIndex index(params);
+        REQUIRE(index.numPoints() == numPoints);
+
+        for (int query = 0; query < 100; query++) {
+            int lo = numPoints ? gen() % numPoints : 0;
+            int hi = lo + (numPoints - lo ? gen() % (numPoints - lo + 1) : 0);
+            Parameters_t range = params;
+            range.NUMPOINTS = hi - lo;
+            range.X = rangeX;
+            range.Y = rangeY;
+            std::copy(X + lo, X + hi, rangeX);
+            std::copy(Y + lo, Y + hi, rangeY);
+            REQUIRE(index.CMV(lo, hi) == computeCMV(range));
+        }
+    }
+}
+
+TEST_CASE("range decisions and invalid ranges", "[RangeIndex]") {
+    std::mt19937 gen(401);
+    std::vector<double> X(5000), Y(5000);
+    Parameters_t params = randomParameters(gen, 5000, X.data(), Y.data());
+    std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 2);
+    std::array<bool, 15> PUV;
+    for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+    DecidePlan plan = makeDecidePlan(params, LCM, PUV);
+    RangeIndex index(params);
+
+    for (int query = 0; query < 200; query++) {
+        int lo = gen() % 5000;
+        int hi = lo + gen() % (5000 - lo + 1);
+        std::array<bool, 15> CMV = index.CMV(lo, hi);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+        REQUIRE(index.decide(plan, lo, hi) == launchDecision(FUV));
+    }
+    REQUIRE(index.CMV(0, 5000) == computeCMV(params));
+    REQUIRE(index.CMV(-1, 10) == std::array<bool, 15>{});
+    REQUIRE(index.CMV(10, 5001) == std::array<bool, 15>{});
+    REQUIRE(index.CMV(10, 10) == std::array<bool, 15>{});
+}
+
+// Tests for the decision timeline
+
+TEST_CASE("timeline matches deciding on every prefix", "[decisionTimeline]") {
+    std::mt19937 gen(410);
+    double X[80], Y[80];
+    for (int round = 0; round < 300; round++) {
+        int numPoints = gen() % 80;
+        Parameters_t params = randomParameters(gen, numPoints, X, Y);
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 4);
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 3 == 0;
+        DecidePlan plan = makeDecidePlan(params, LCM, PUV);
+        DecisionTimeline timeline = decisionTimeline(plan, X, Y, numPoints);
+
+        for (int prefix = 0; prefix <= numPoints; prefix++) {
+            Parameters_t head = params;
+            head.NUMPOINTS = prefix;
+            std::array<bool, 15> CMV = computeCMV(head);
+            std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+            REQUIRE(timelineCMV(timeline, prefix) == CMV);
+            REQUIRE(timelineLaunch(timeline, prefix) == launchDecision(FUV));
+            for (int i = 0; i < 15; i++) {
+                REQUIRE((timeline.fuvLatch[i] >= 0 && prefix >= timeline.fuvLatch[i]) == FUV[i]);
+            }
+            for (int lic = 12; lic < 15; lic++) {
+                unsigned flags = licScan(lic, head, 0, std::max(licWindowCount(lic, head), 0));
+                REQUIRE(((flags & 2) != 0) == (timeline.flagLatch[1][lic] >= 0 && prefix >= timeline.flagLatch[1][lic]));
+            }
+        }
+    }
+}
+
+TEST_CASE("timeline events are in prefix order, causes first", "[decisionTimeline]") {
+    // Consecutive points 3 apart from the fourth point on: LIC 0 latches at prefix 5
+    double X[8] = {0, 1, 2, 3, 6, 9, 12, 15}, Y[8] = {0};
+    Parameters_t params = {};
+    params.LENGTH1 = 2;
+    params.RADIUS1 = 100;
+    std::array<std::array<Connectors, 15>, 15> LCM;
+    for (auto &row : LCM) row.fill(NOTUSED);
+    LCM[0][1] = LCM[1][0] = ORR;
+    std::array<bool, 15> PUV{};
+    PUV[0] = true;
+    DecisionTimeline timeline = decisionTimeline(makeDecidePlan(params, LCM, PUV), X, Y, 8);
+
+    REQUIRE(timeline.cmvLatch[0] == 5);
+    REQUIRE(timeline.fuvLatch[0] == 5);
+    REQUIRE(timeline.fuvLatch[1] == 0);
+    REQUIRE(timeline.launchLatch == 5);
+    for (size_t e = 1; e < timeline.events.size(); e++) {
+        REQUIRE(timeline.events[e - 1].points <= timeline.events[e].points);
+    }
+    int cmvAt = -1, launchAt = -1;
+    for (size_t e = 0; e < timeline.events.size(); e++) {
+        if (timeline.events[e].stage == TIMELINE_CMV && timeline.events[e].index == 0) cmvAt = e;
+        if (timeline.events[e].stage == TIMELINE_LAUNCH) launchAt = e;
+    }
+    REQUIRE(cmvAt >= 0);
+    REQUIRE(cmvAt < launchAt);
+}
+
+// Tests for the parallel executor
+
+TEST_CASE("settled launch matches every completion of the CMV", "[settledLaunch]") {
+    std::mt19937 gen(420);
+    for (int round = 0; round < 3000; round++) {
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 6);
+        SparseLCM sparse = sparseLCM(packLCM(LCM));
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 3 == 0;
+        uint16_t known = gen() & 0x7fff, CMV = gen() & 0x7fff;
+        // Unknown entries are few enough to try every completion
+        known |= 0x7fff & ~(0xfu << (gen() % 12));
+        int outcome = settledLaunch(known, CMV, sparse, PUV);
+
+        bool sawTrue = false, sawFalse = false;
+        uint16_t unknown = 0x7fff & ~known;
+        for (uint16_t fill = unknown;; fill = (fill - 1) & unknown) {
+            std::array<bool, 15> full;
+            for (int i = 0; i < 15; i++) full[i] = ((CMV & known) | fill) >> i & 1;
+            bool launch = launchDecision(generateFinalUnlockingVector(full, sparse, PUV));
+            sawTrue = sawTrue || launch;
+            sawFalse = sawFalse || !launch;
+            if (fill == 0) break;
+        }
+        if (outcome == 1) REQUIRE(!sawFalse);
+        if (outcome == 0) REQUIRE(!sawTrue);
+        if (known == 0x7fff) REQUIRE(outcome >= 0);
+    }
+}
+
+TEST_CASE("parallel decisions match the sequential pipeline", "[decideParallel]") {
+    std::mt19937 gen(421);
+    std::vector<double> X(3000), Y(3000);
+    for (int round = 0; round < 200; round++) {
+        int numPoints = gen() % 3000;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 4);
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+        DecidePlan plan = makeDecidePlan(params, LCM, PUV);
+
+        std::array<bool, 15> CMV = computeCMV(params);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+        CancellationToken token;
+        ParallelDecision decision = decideParallel(plan, X.data(), Y.data(), numPoints, 1 + round % 6, token);
+        REQUIRE(decision.launch == launchDecision(FUV));
+        for (int i = 0; i < 15; i++) {
+            if (decision.known >> i & 1) REQUIRE(decision.CMV[i] == CMV[i]);
+        }
+    }
+}
+
+TEST_CASE("cancelled LIC scans stop without a result", "[cancellableLic]") {
+    std::mt19937 gen(422);
+    std::vector<double> X(2000), Y(2000);
+    Parameters_t params = randomParameters(gen, 2000, X.data(), Y.data());
+    CancellationToken token;
+    for (int lic = 0; lic < 15; lic++) {
+        bool completed = false;
+        REQUIRE(cancellableLic(lic, params, token, completed) == evaluateLic(lic, params));
+        REQUIRE(completed);
+    }
+
+    token.cancel();
+    for (int lic = 0; lic < 15; lic++) {
+        bool completed = true;
+        if (licWindowCount(lic, params) > 0) {
+            REQUIRE(cancellableLic(lic, params, token, completed) == false);
+            REQUIRE(completed == false);
+        }
+    }
+
+    // An all false PUV settles the launch before any LIC runs
+    CancellationToken fresh;
+    ParallelDecision decision = decideParallel(makeDecidePlan(params), X.data(), Y.data(), 2000, 4, fresh);
+    REQUIRE(decision.launch);
+    REQUIRE(decision.known == 0);
+    REQUIRE(fresh.cancelled());
+}
+
+// Tests for the work-stealing scheduler
+
+TEST_CASE("work-stealing pool runs every task once, nested tasks included", "[WorkStealingPool]") {
+    WorkStealingPool pool(4);
+    REQUIRE(pool.workers() == 4);
+    std::vector<std::atomic<int>> runs(1000);
+    for (std::atomic<int> &r : runs) r = 0;
+
+    // Each task forks ten children from inside a worker and waits for them
+    auto outer = [&](int i) {
+        auto inner = [&](int j) { runs[i * 10 + j]++; };
+        pool.parallelFor(10, inner);
+    };
+    pool.parallelFor(100, outer);
+    for (std::atomic<int> &r : runs) REQUIRE(r == 1);
+
+    // Tasks of very different cost still all finish
+    std::atomic<long> total{0};
+    auto uneven = [&](int i) {
+        long sum = 0;
+        for (int k = 0; k < (i % 8 == 0 ? 200000 : 10); k++) sum += k % 7;
+        total += sum;
+    };
+    pool.parallelFor(256, uneven);
+    long expected = 0;
+    for (int i = 0; i < 256; i++) {
+        for (int k = 0; k < (i % 8 == 0 ? 200000 : 10); k++) expected += k % 7;
+    }
+    REQUIRE(total == expected);
+}
+
+TEST_CASE("waiting for a long task sleeps instead of spinning", "[WorkStealingPool]") {
+    WorkStealingPool pool(2);
+    std::atomic<bool> started{false};
+    TaskGroup group;
+    pool.spawnOn(0, group, [](void *context, int) {
+        *(std::atomic<bool> *)context = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }, &started, 0);
+    // Only wait once a worker runs the task, so this thread has nothing to help with
+    while (!started) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    timespec before, after;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &before);
+    pool.wait(group);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &after);
+    REQUIRE(group.pending() == 0);
+    double cpuSeconds = (after.tv_sec - before.tv_sec) + (after.tv_nsec - before.tv_nsec) * 1e-9;
+    REQUIRE(cpuSeconds < 0.1);
+}
+
+TEST_CASE("chunked parallel decisions and batches match the pipeline", "[decideBatch]") {
+    std::mt19937 gen(430);
+    WorkStealingPool pool(4);
+    PointSetPool points;
+    std::vector<PointSetView> items;
+    std::vector<double> X(20000), Y(20000);
+    Parameters_t params = randomParameters(gen, 0, X.data(), Y.data());
+    std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 2);
+    std::array<bool, 15> PUV;
+    for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+    DecidePlan plan = makeDecidePlan(params, LCM, PUV);
+
+    for (int round = 0; round < 60; round++) {
+        int numPoints = round % 10 == 0 ? 20000 : gen() % 600;
+        randomParameters(gen, numPoints, X.data(), Y.data());
+        items.push_back(points.add(X.data(), Y.data(), numPoints));
+    }
+
+    std::vector<BatchDecision> results(items.size());
+    decideBatch(pool, plan, items.data(), (int)items.size(), results.data());
+    for (size_t k = 0; k < items.size(); k++) {
+        Parameters_t set = withPoints(params, items[k]);
+        std::array<bool, 15> CMV = computeCMV(set);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+        REQUIRE(results[k].CMV == CMV);
+        REQUIRE(results[k].FUV == FUV);
+        REQUIRE(results[k].launch == launchDecision(FUV));
+
+        CancellationToken token;
+        ParallelDecision decision = decideParallel(pool, plan, items[k].X, items[k].Y, items[k].NUMPOINTS, token);
+        REQUIRE(decision.launch == launchDecision(FUV));
+        for (int i = 0; i < 15; i++) {
+            if (decision.known >> i & 1) REQUIRE(decision.CMV[i] == CMV[i]);
+        }
+    }
+}
+
+TEST_CASE("placed batches decide like the copies they were made from", "[BatchPlacement]") {
+    std::mt19937 gen(440);
+    WorkStealingPool pool(3, true);
+    BatchPlacement placement(pool);
+    std::vector<double> X(400 * 300), Y(400 * 300);
+    std::vector<PointSetView> items;
+    Parameters_t params = randomParameters(gen, 0, X.data(), Y.data());
+    DecidePlan plan = makeDecidePlan(params, randomSymmetricLCM(gen, 2), std::array<bool, 15>{});
+
+    for (int k = 0; k < 300; k++) {
+        int numPoints = gen() % 400;
+        randomParameters(gen, numPoints, X.data() + k * 400, Y.data() + k * 400);
+        items.push_back({X.data() + k * 400, Y.data() + k * 400, numPoints});
+    }
+    for (int batch = 0; batch < 3; batch++) {
+        placement.place(items.data(), (int)items.size());
+        REQUIRE(placement.size() == 300);
+        REQUIRE(placement.runs() == (300 + BATCH_RUN - 1) / BATCH_RUN);
+        for (int k = 0; k < 300; k++) {
+            REQUIRE(placement.items()[k].X != items[k].X);
+            REQUIRE(std::equal(items[k].X, items[k].X + items[k].NUMPOINTS, placement.items()[k].X));
+            REQUIRE(std::equal(items[k].Y, items[k].Y + items[k].NUMPOINTS, placement.items()[k].Y));
+        }
+
+        std::vector<BatchDecision> placed(300), copied(300);
+        decideBatch(plan, placement, placed.data());
+        decideBatch(pool, plan, items.data(), 300, copied.data());
+        for (int k = 0; k < 300; k++) {
+            REQUIRE(placed[k].launch == copied[k].launch);
+            REQUIRE(placed[k].CMV == copied[k].CMV);
+            REQUIRE(placed[k].CMV == computeCMV(withPoints(params, items[k])));
+        }
+    }
+}
+
+// Tests for the bounding-box index
+
+TEST_CASE("box cover contains every point of the range", "[BoxIndex]") {
+    std::mt19937 gen(450);
+    std::uniform_real_distribution<double> coordinate(-100, 100);
+    std::vector<double> X(1000), Y(1000);
+    for (int i = 0; i < 1000; i++) {
+        X[i] = coordinate(gen);
+        Y[i] = coordinate(gen);
+    }
+    Parameters_t params = {};
+    params.NUMPOINTS = 1000;
+    params.X = X.data();
+    params.Y = Y.data();
+    BoxIndex boxes(params);
+    REQUIRE(boxes.numPoints() == 1000);
+
+    for (int query = 0; query < 2000; query++) {
+        int first = gen() % 1000;
+        int last = first + gen() % (1000 - first);
+        PointBox box = boxes.cover(first, last);
+        for (int i = first; i <= last; i++) {
+            REQUIRE(box.minX <= X[i]);
+            REQUIRE(X[i] <= box.maxX);
+            REQUIRE(box.minY <= Y[i]);
+            REQUIRE(Y[i] <= box.maxY);
+        }
+    }
+}
+
+TEST_CASE("pruned LICs 0, 1, 7 and 12 match the full scans", "[prunedLic]") {
+    std::mt19937 gen(451);
+    std::uniform_real_distribution<double> step(-0.01, 0.01);
+    const double special[] = {NAN, INFINITY, -INFINITY, 1e300, -1e300};
+    std::vector<double> X(3000), Y(3000);
+    for (int round = 0; round < 400; round++) {
+        int numPoints = gen() % 3000;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        // Slow dense motion with a few jumps, the case the boxes are for
+        if (round % 2 == 0) {
+            for (int i = 1; i < numPoints; i++) {
+                X[i] = X[i-1] + step(gen) + (gen() % 2000 == 0 ? 5.0 : 0.0);
+                Y[i] = Y[i-1] + step(gen);
+            }
+            params.LENGTH1 = std::fabs(params.LENGTH1) / 10;
+            params.RADIUS1 = std::fabs(params.RADIUS1) / 20;
+        }
+        if (round % 10 == 0 && numPoints > 0) X[gen() % numPoints] = special[gen() % 5];
+
+        BoxIndex boxes(params);
+        for (int lic : {0, 1, 7, 12}) {
+            REQUIRE(prunedLic(lic, params, boxes) == evaluateLic(lic, params));
+        }
+        REQUIRE(computeCMV(boxes, params) == computeCMV(params));
+    }
+}
+
+// Tests for the chunked decide
+
+TEST_CASE("ChunkedDecider matches computeCMV for any chunking", "[ChunkedDecider]") {
+    std::mt19937 gen(461);
+    std::vector<double> X(600), Y(600);
+    for (int round = 0; round < 400; round++) {
+        int numPoints = gen() % 600;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        ChunkedDecider decider(params, 1 + gen() % 100);
+        int added = 0;
+        while (added < numPoints) {
+            int count = std::min(numPoints - added, (int)(gen() % 40));
+            decider.add(X.data() + added, Y.data() + added, count);
+            added += count;
+        }
+        REQUIRE(decider.numPoints() == numPoints);
+        REQUIRE(decider.finish() == computeCMV(params));
+    }
+}
+
+TEST_CASE("ChunkedDecider keeps only a chunk and the largest window span", "[ChunkedDecider]") {
+    Parameters_t params = {};
+    params.A_PTS = params.B_PTS = 1;
+    params.C_PTS = params.D_PTS = 1;
+    params.E_PTS = params.F_PTS = 1;
+    params.G_PTS = params.K_PTS = 1;
+    params.N_PTS = params.Q_PTS = 3;
+    params.QUADS = 1;
+    params.LENGTH1 = params.LENGTH2 = 1e9;
+    params.RADIUS1 = params.RADIUS2 = 1e9;
+    params.AREA1 = params.AREA2 = 1e9;
+    params.DIST = 1e9;
+    ChunkedDecider decider(params, 64);
+
+    double x[1000], y[1000];
+    for (int i = 0; i < 1000; i++) {
+        x[i] = -i;
+        y[i] = 0;
+    }
+    long before = heapAllocations;
+    for (int block = 0; block < 1000; block++) {
+        decider.add(x, y, 1000);
+    }
+    REQUIRE(heapAllocations == before);
+    REQUIRE(decider.numPoints() == 1000000);
+    std::array<bool, 15> CMV = decider.finish();
+    REQUIRE_FALSE(CMV[0]);
+    REQUIRE(CMV[5]);
+}
+
+TEST_CASE("chunkedCMVFromFile decides a mapped file of points", "[chunkedCMVFromFile]") {
+    std::mt19937 gen(462);
+    std::vector<double> X(5000), Y(5000);
+    char path[] = "/tmp/decide-chunkedXXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    close(fd);
+
+    for (int round = 0; round < 20; round++) {
+        int numPoints = gen() % 5000;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        FILE *file = fopen(path, "wb");
+        for (int i = 0; i < numPoints; i++) {
+            double point[2] = {X[i], Y[i]};
+            fwrite(point, sizeof(point), 1, file);
+        }
+        fclose(file);
+
+        std::array<bool, 15> CMV;
+        REQUIRE(chunkedCMVFromFile(path, params, 1 + gen() % 1000, CMV));
+        REQUIRE(CMV == computeCMV(params));
+
+        // Chunk sizes below 1 are taken as 1
+        if (round < 3) {
+            REQUIRE(chunkedCMVFromFile(path, params, -round, CMV));
+            REQUIRE(CMV == computeCMV(params));
+        }
+    }
+
+    FILE *file = fopen(path, "wb");
+    fwrite("odd", 3, 1, file);
+    fclose(file);
+    std::array<bool, 15> CMV;
+    REQUIRE_FALSE(chunkedCMVFromFile(path, Parameters_t{}, 100, CMV));
+    unlink(path);
+    REQUIRE_FALSE(chunkedCMVFromFile(path, Parameters_t{}, 100, CMV));
+}
+
+// Tests for the sharded decide
+
+TEST_CASE("decideSharded matches decideBatch", "[decideSharded]") {
+    std::mt19937 gen(470);
+    WorkStealingPool pool(2);
+    PointSetPool points;
+    std::vector<PointSetView> items;
+    std::vector<double> X(5000), Y(5000);
+    Parameters_t params = randomParameters(gen, 0, X.data(), Y.data());
+    std::array<bool, 15> PUV;
+    for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+    DecidePlan plan = makeDecidePlan(params, randomSymmetricLCM(gen, 2), PUV);
+
+    for (int k = 0; k < 300; k++) {
+        int numPoints = k % 50 == 0 ? 5000 : gen() % 300;
+        randomParameters(gen, numPoints, X.data(), Y.data());
+        items.push_back(points.add(X.data(), Y.data(), numPoints));
+    }
+
+    std::vector<BatchDecision> expected(items.size());
+    decideBatch(pool, plan, items.data(), (int)items.size(), expected.data());
+    for (int shards : {1, 3, 8}) {
+        std::vector<BatchDecision> results(items.size());
+        std::vector<ShardStatus> status(items.size());
+        REQUIRE(decideSharded(plan, items.data(), (int)items.size(), shards, results.data(), status.data()));
+        for (size_t k = 0; k < items.size(); k++) {
+            REQUIRE(status[k] == SHARD_DECIDED);
+            REQUIRE(results[k].CMV == expected[k].CMV);
+            REQUIRE(results[k].FUV == expected[k].FUV);
+            REQUIRE(results[k].launch == expected[k].launch);
+        }
+    }
+    REQUIRE(decideSharded(plan, items.data(), 0, 4, nullptr, nullptr));
+}
+
+TEST_CASE("decideSharded fails only the point set that exceeds its worker's memory", "[decideSharded]") {
+    std::mt19937 gen(471);
+    PointSetPool points;
+    std::vector<PointSetView> items;
+    std::vector<double> X(2000000), Y(2000000);
+    Parameters_t params = randomParameters(gen, 0, X.data(), Y.data());
+    DecidePlan plan = makeDecidePlan(params, randomSymmetricLCM(gen, 2), std::array<bool, 15>{});
+
+    for (int k = 0; k < 200; k++) {
+        int numPoints = k == 100 ? 2000000 : gen() % 300;
+        randomParameters(gen, numPoints, X.data(), Y.data());
+        items.push_back(points.add(X.data(), Y.data(), numPoints));
+    }
+
+    std::vector<BatchDecision> results(items.size());
+    std::vector<ShardStatus> status(items.size());
+    REQUIRE(decideSharded(plan, items.data(), (int)items.size(), 2, results.data(), status.data(), 16 << 20));
+    for (size_t k = 0; k < items.size(); k++) {
+        if (k == 100) {
+            REQUIRE(status[k] == SHARD_FAILED);
+            REQUIRE_FALSE(results[k].launch);
+        } else {
+            REQUIRE(status[k] == SHARD_DECIDED);
+            REQUIRE(results[k].CMV == computeCMV(withPoints(params, items[k])));
+        }
+    }
+}
+
+// Tests for the real-time mode
+
+TEST_CASE("decideRealtime matches the pipeline without allocating", "[decideRealtime]") {
+    std::mt19937 gen(480);
+    std::vector<double> X(400), Y(400);
+    for (int round = 0; round < 300; round++) {
+        int numPoints = gen() % 400;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 2);
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+        DecidePlan plan = makeDecidePlan(params, LCM, PUV);
+
+        long before = heapAllocations;
+        RealtimeDecision decision = decideRealtime(plan, X.data(), Y.data(), numPoints);
+        REQUIRE(heapAllocations == before);
+
+        std::array<bool, 15> CMV = computeCMV(params);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(generatePreliminaryUnlockingMatrix(CMV, LCM), PUV);
+        REQUIRE(decision.CMV == CMV);
+        REQUIRE(decision.FUV == FUV);
+        REQUIRE(decision.launch == launchDecision(FUV));
+    }
+}
+
+TEST_CASE("licCostBound grows with the points and covers every window", "[licCostBound]") {
+    std::mt19937 gen(481);
+    for (int round = 0; round < 200; round++) {
+        Parameters_t params = randomParameters(gen, 0, nullptr, nullptr);
+        for (int lic = 0; lic < 15; lic++) {
+            long long previous = 0;
+            for (int numPoints : {0, 3, 10, 100, 1000}) {
+                params.NUMPOINTS = numPoints;
+                long long bound = licCostBound(lic, params, numPoints);
+                REQUIRE(bound >= previous);
+                REQUIRE(bound >= 1 + (long long)std::max(licWindowCount(lic, params), 0));
+                previous = bound;
+            }
+        }
+    }
+}
+
+TEST_CASE("a measured WCET profile decides which plans fit a budget", "[fits]") {
+    std::mt19937 gen(482);
+    PointSetPool points;
+    std::vector<PointSetView> corpus;
+    stressCorpus(points, 500, corpus);
+    REQUIRE(corpus.size() >= 6);
+
+    Parameters_t params = randomParameters(gen, 0, nullptr, nullptr);
+    DecidePlan plan = makeDecidePlan(params, randomSymmetricLCM(gen, 2), std::array<bool, 15>{});
+    WcetProfile profile = measureWcet(plan, corpus.data(), (int)corpus.size(), 3);
+    REQUIRE(profile.stageNs >= 0);
+
+    WcetReport small = wcetReport(plan, 100, profile);
+    WcetReport large = wcetReport(plan, 100000, profile);
+    REQUIRE(small.totalNs > 0);
+    REQUIRE(large.totalNs >= small.totalNs);
+    for (int lic = 0; lic < 15; lic++) {
+        REQUIRE(std::isfinite(profile.nsPerUnit[lic]));
+        REQUIRE(large.units[lic] >= small.units[lic]);
+    }
+    REQUIRE(fits(plan, 100, profile, large.totalNs));
+    REQUIRE_FALSE(fits(plan, 100000, profile, small.totalNs / 2));
+}
+
+// Tests for the LIC dispatcher
+
+TEST_CASE("every LIC implementation gives the same result", "[evaluateLicWith]") {
+    std::mt19937 gen(490);
+    WorkStealingPool pool(3);
+    std::vector<double> X(6000), Y(6000);
+    for (int round = 0; round < 150; round++) {
+        int numPoints = round % 15 == 0 ? 6000 : gen() % 400;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        for (int lic = 0; lic < 15; lic++) {
+            bool expected = evaluateLic(lic, params);
+            for (int implementation = 0; implementation < LIC_IMPLEMENTATIONS; implementation++) {
+                REQUIRE(evaluateLicWith((LicImplementation)implementation, lic, params, &pool) == expected);
+            }
+            REQUIRE(evaluateLicWith(LIC_THREADED, lic, params, nullptr) == expected);
+        }
+    }
+}
+
+TEST_CASE("a calibrated LicDispatcher picks per size and matches computeCMV", "[LicDispatcher]") {
+    std::mt19937 gen(491);
+    WorkStealingPool pool(2);
+    LicDispatcher dispatcher(&pool);
+    Parameters_t probe = randomParameters(gen, 0, nullptr, nullptr);
+    for (int lic = 0; lic < 15; lic++) REQUIRE(dispatcher.choice(lic, probe) == LIC_KERNEL);
+
+    dispatcher.calibrate(2048, 2);
+    std::vector<double> X(3000), Y(3000);
+    for (int round = 0; round < 200; round++) {
+        int numPoints = gen() % 3000;
+        Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+        REQUIRE(dispatcher.computeCMV(params) == computeCMV(params));
+        for (int lic = 0; lic < 15; lic++) {
+            REQUIRE(dispatcher.evaluate(lic, params) == evaluateLic(lic, params));
+        }
+    }
+
+    REQUIRE(dispatchSizeClass(0) == 0);
+    REQUIRE(dispatchSizeClass(8) == 0);
+    REQUIRE(dispatchSizeClass(9) == 1);
+    REQUIRE(dispatchSizeClass(1 << 30) == DISPATCH_SIZES - 1);
+}
+
+TEST_CASE("calibration parameters scan every window of every LIC", "[LicDispatcher]") {
+    std::vector<double> X(2048), Y(2048);
+    calibrationPoints(X.data(), Y.data(), 2048);
+    for (int span = 0; span < DISPATCH_SPANS; span++) {
+        Parameters_t params = calibrationParameters(span, X.data(), Y.data(), 2048);
+        for (int lic = 0; lic < 15; lic++) {
+            REQUIRE(licWindowCount(lic, params) > 0);
+            REQUIRE_FALSE(evaluateLic(lic, params));
+        }
+    }
+}
+
+TEST_CASE("a LicDispatcher profile survives save and load", "[LicDispatcher]") {
+    LicDispatcher saved;
+    for (int lic = 0; lic < 15; lic++) {
+        saved.setChoice(lic, lic % DISPATCH_SIZES, lic % DISPATCH_SPANS, (LicImplementation)(lic % LIC_IMPLEMENTATIONS));
+    }
+    char path[] = "/tmp/decide-dispatchXXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    close(fd);
+    REQUIRE(saved.save(path));
+
+    LicDispatcher loaded;
+    REQUIRE(loaded.load(path));
+    std::mt19937 gen(492);
+    std::vector<double> X(1 << 16), Y(1 << 16);
+    for (int lic = 0; lic < 15; lic++) {
+        for (int numPoints : {5, 30, 100, 1000, 1 << 16}) {
+            Parameters_t params = randomParameters(gen, numPoints, X.data(), Y.data());
+            REQUIRE(loaded.choice(lic, params) == saved.choice(lic, params));
+        }
+    }
+
+    FILE *file = fopen(path, "w");
+    fputs("decide-dispatch 1\n0 0 0 fastest\n", file);
+    fclose(file);
+    LicDispatcher untouched;
+    REQUIRE_FALSE(untouched.load(path));
+    unlink(path);
+    REQUIRE_FALSE(untouched.load(path));
+    Parameters_t params = randomParameters(gen, 0, nullptr, nullptr);
+    for (int lic = 0; lic < 15; lic++) REQUIRE(untouched.choice(lic, params) == LIC_KERNEL);
+}
+
+// Tests for the condition registry
+
+// Site condition of the tests: more points than the threshold in context, counting its calls
+typedef struct {
+    int threshold;
+    int calls;
+} CountingCondition;
+
+static bool moreThan(const Parameters_t &params, const void *context) {
+    CountingCondition &condition = *(CountingCondition *)context;
+    condition.calls++;
+    return params.NUMPOINTS > condition.threshold;
+}
+
+TEST_CASE("the built-in conditions reproduce the classic decision", "[ConditionRegistry]") {
+    std::mt19937 gen(500);
+    ConditionRegistry registry;
+    REQUIRE(registry.size() == 15);
+    REQUIRE(registry.find("LIC7") == 7);
+    REQUIRE(registry.find("LIC15") == -1);
+
+    std::vector<double> X(300), Y(300);
+    for (int round = 0; round < 300; round++) {
+        Parameters_t params = randomParameters(gen, gen() % 300, X.data(), Y.data());
+        std::array<std::array<Connectors, 15>, 15> LCM = randomSymmetricLCM(gen, 1 + round % 4);
+        std::array<bool, 15> PUV;
+        for (int i = 0; i < 15; i++) PUV[i] = gen() % 2;
+        UnlockingLogic logic(LCM, PUV);
+
+        std::array<bool, 15> CMV = computeCMV(params);
+        std::array<std::array<bool, 15>, 15> PUM = generatePreliminaryUnlockingMatrix(CMV, LCM);
+        std::array<bool, 15> FUV = generateFinalUnlockingVector(PUM, PUV);
+        ConditionBits bits = registry.computeCMV(params);
+        std::vector<ConditionBits> rows = logic.PUM(bits);
+        ConditionBits finalBits = logic.FUV(bits);
+        for (int i = 0; i < 15; i++) {
+            REQUIRE(bits.test(i) == CMV[i]);
+            REQUIRE(finalBits.test(i) == FUV[i]);
+            for (int j = 0; j < 15; j++) REQUIRE(rows[i].test(j) == PUM[i][j]);
+        }
+        REQUIRE(logic.launch(bits) == launchDecision(FUV));
+        REQUIRE(decideConditions(registry, logic, params) == launchDecision(FUV));
+    }
+}
+
+TEST_CASE("256 conditions decide like an entry by entry PUM and FUV", "[UnlockingLogic]") {
+    std::mt19937 gen(501);
+    const int size = 256;
+    ConditionRegistry registry;
+    std::vector<CountingCondition> sites(size - 15);
+    for (int k = 0; k < size - 15; k++) {
+        sites[k].threshold = gen() % 300;
+        REQUIRE(registry.add("site" + std::to_string(k), &moreThan, &sites[k], 1 + gen() % 5) == 15 + k);
+    }
+    REQUIRE(registry.find("site100") == 115);
+    for (size_t k = 1; k < registry.costOrder().size(); k++) {
+        REQUIRE(registry.condition(registry.costOrder()[k-1]).cost <= registry.condition(registry.costOrder()[k]).cost);
+    }
+
+    std::vector<double> X(300), Y(300);
+    for (int round = 0; round < 100; round++) {
+        Parameters_t params = randomParameters(gen, gen() % 300, X.data(), Y.data());
+        UnlockingLogic logic(size);
+        std::vector<std::vector<Connectors>> LCM(size, std::vector<Connectors>(size, NOTUSED));
+        for (int row = 0; row < size; row++) {
+            for (int column = 0; column < size; column++) {
+                int pick = gen() % 100;
+                if (pick < 100 - 2 * (round % 10)) continue;
+                LCM[row][column] = pick % 2 ? ANDD : ORR;
+                logic.setConnector(row, column, LCM[row][column]);
+            }
+            logic.setPUV(row, gen() % 4 == 0);
+        }
+
+        ConditionBits CMV = registry.computeCMV(params);
+        ConditionBits FUV = logic.FUV(CMV);
+        bool launch = true;
+        for (int row = 0; row < size; row++) {
+            ConditionBits PUMRow = logic.PUMRow(CMV, row);
+            bool rowTrue = true;
+            for (int column = 0; column < size; column++) {
+                bool entry = true;
+                if (row != column && LCM[row][column] == ANDD) entry = CMV.test(row) && CMV.test(column);
+                if (row != column && LCM[row][column] == ORR) entry = CMV.test(row) || CMV.test(column);
+                REQUIRE(PUMRow.test(column) == entry);
+                REQUIRE(logic.connector(row, column) == (row == column ? NOTUSED : LCM[row][column]));
+                rowTrue = rowTrue && entry;
+            }
+            REQUIRE(FUV.test(row) == (!logic.PUV().test(row) || rowTrue));
+            launch = launch && FUV.test(row);
+        }
+        REQUIRE(logic.launch(CMV) == launch);
+        REQUIRE(decideConditions(registry, logic, params) == launch);
+    }
+}
+
+TEST_CASE("decideConditions skips conditions the decision cannot depend on", "[decideConditions]") {
+    ConditionRegistry registry;
+    CountingCondition never = {1000, 0}, expensive = {0, 0}, unused = {0, 0};
+    int cheap = registry.add("never", &moreThan, &never, 0.5);
+    int costly = registry.add("expensive", &moreThan, &expensive, 100);
+    registry.add("unused", &moreThan, &unused, 0.1);
+
+    UnlockingLogic logic(registry.size());
+    logic.setConnector(cheap, costly, ANDD);
+    logic.setPUV(cheap, true);
+
+    double X[10] = {}, Y[10] = {};
+    Parameters_t params = {};
+    params.NUMPOINTS = 10;
+    params.X = X;
+    params.Y = Y;
+    ConditionBits CMV;
+    REQUIRE_FALSE(decideConditions(registry, logic, params, &CMV));
+    REQUIRE(never.calls == 1);
+    REQUIRE(expensive.calls == 0);
+    REQUIRE(unused.calls == 0);
+    REQUIRE(CMV.count() == 0);
+
+    logic.setConnector(cheap, costly, ORR);
+    REQUIRE(decideConditions(registry, logic, params, &CMV));
+    REQUIRE(expensive.calls == 1);
+    REQUIRE(unused.calls == 0);
+    REQUIRE(CMV.test(costly));
+}